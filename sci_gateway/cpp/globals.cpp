@@ -5,9 +5,14 @@
  * By Keyur Joshi and Sai Kiran
  */
 #include <symphony.h>
+#include "globals.hpp"
 #include <sciprint.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
 
 sym_environment *global_sym_env=0;
+extern int c_count; //defined in symphony, the tree manager stops at the next node when it becomes positive
 
 extern "C"{
 int process_ret_val(int ret_val){
@@ -30,7 +35,7 @@ int process_ret_val(int ret_val){
 			sciprint("A feasible solution has been found. It may not be optimal.");
 			break;
 		case TM_SIGNAL_CAUGHT:
-			sciprint("TM_SIGNAL_CAUGHT");
+			sciprint("The solver was interrupted. The best solution found so far is available.");
 			break;
 		case TM_UNBOUNDED:
 			sciprint("This problem or its solution is unbounded.");
@@ -98,4 +103,128 @@ int process_ret_val(int ret_val){
 	return status;
 }
 
+//the group of solves that owns c_count and the SIGINT handler, see globals.hpp
+static pthread_mutex_t group_lock=PTHREAD_MUTEX_INITIALIZER;
+static pthread_t group_guard;
+static struct sigaction group_handler,group_previous;
+static volatile int solving=0,guarded=0;
+
+//why the group is stopping; Ctrl-C, the end of a slice and the stop flag ask the tree managers of the group to stop
+static volatile int stopping=SOLVE_NOT_STOPPED;
+static volatile int *group_stop=NULL;
+
+//a group given a slice of time is asked to stop when the slice is over
+static struct timespec slice_end;
+static volatile int sliced=0;
+
+//a group in the background leaves Ctrl-C to the handler that was there before it
+static void catch_interrupt(int sig){
+	if(group_stop==NULL){
+		stopping=SOLVE_INTERRUPTED;
+		c_count=1;
+	}else if(!(group_previous.sa_flags&SA_SIGINFO) && group_previous.sa_handler!=SIG_DFL && group_previous.sa_handler!=SIG_IGN)
+		group_previous.sa_handler(sig);
+}
+
+//symphony installs its own handler when a tree manager starts, which prompts on the console, so ours is
+//installed again for as long as the group runs; a solve starting in the group may also clear c_count,
+//so it is set again while the group is stopping
+static void *guard_interrupt(void *arg){
+	struct sigaction current;
+	struct timespec pause={0,20000000},now;
+	while(solving){
+		sigaction(SIGINT,NULL,&current);
+		if(current.sa_handler!=catch_interrupt)
+			sigaction(SIGINT,&group_handler,NULL);
+		if(group_stop!=NULL && *group_stop && stopping==SOLVE_NOT_STOPPED)
+			stopping=SOLVE_CANCELLED;
+		if(sliced && stopping==SOLVE_NOT_STOPPED){
+			clock_gettime(CLOCK_MONOTONIC,&now);
+			if(now.tv_sec>slice_end.tv_sec || (now.tv_sec==slice_end.tv_sec && now.tv_nsec>=slice_end.tv_nsec))
+				stopping=SOLVE_SLICE_OVER;
+		}
+		if(stopping!=SOLVE_NOT_STOPPED)
+			c_count=1;
+		nanosleep(&pause,NULL);
+	}
+	return NULL;
+}
+
+void solve_group_begin(double seconds, volatile int *stop){
+	if(pthread_mutex_trylock(&group_lock)){
+		if(stop==NULL)
+			sciprint("Waiting for the background solve to finish before solving.\n");
+		pthread_mutex_lock(&group_lock);
+	}
+	group_stop=stop;
+	group_handler.sa_handler=catch_interrupt;
+	sigemptyset(&group_handler.sa_mask);
+	group_handler.sa_flags=0;
+	c_count=0;
+	stopping=(stop!=NULL && *stop)?SOLVE_CANCELLED:SOLVE_NOT_STOPPED;
+	sliced=(seconds>=0);
+	if(sliced){
+		clock_gettime(CLOCK_MONOTONIC,&slice_end);
+		slice_end.tv_sec+=(time_t)seconds;
+		slice_end.tv_nsec+=(long)((seconds-(time_t)seconds)*1e9);
+		if(slice_end.tv_nsec>=1000000000){
+			slice_end.tv_sec++;
+			slice_end.tv_nsec-=1000000000;
+		}
+	}
+	sigaction(SIGINT,&group_handler,&group_previous);
+	solving=1;
+	guarded=(pthread_create(&group_guard,NULL,guard_interrupt,NULL)==0);
+}
+
+int group_solve(sym_environment *env, int warm){
+	if(stopping!=SOLVE_NOT_STOPPED)
+		return TM_SIGNAL_CAUGHT;
+	if(warm)
+		return sym_warm_solve(env);
+	return sym_solve(env);
+}
+
+int solve_group_stopping(){
+	return stopping!=SOLVE_NOT_STOPPED;
+}
+
+int solve_group_end(){
+	int stopped=stopping;
+	solving=0;
+	if(guarded)
+		pthread_join(group_guard,NULL);
+	sigaction(SIGINT,&group_previous,NULL);
+	sliced=0;
+	stopping=SOLVE_NOT_STOPPED;
+	group_stop=NULL;
+	c_count=0;
+	pthread_mutex_unlock(&group_lock);
+	return stopped;
+}
+
+/* Solves the problem in env, from its warm start if warm is nonzero, for at most seconds if it is not negative
+ * Ctrl-C or the end of the slice stops the solve with TM_SIGNAL_CAUGHT, keeping the best solution found so far
+ * and, with the "keep_warm_start" parameter set, the tree, so that a warm solve continues it
+ * paused, if not NULL, is set to 1 if the solve was stopped by the end of the slice and not by Ctrl-C
+ * Returns the return value of symphony
+ */
+int sliced_solve(sym_environment *env, int warm, double seconds, int *paused){
+	int ret_val,stopped;
+	solve_group_begin(seconds,NULL);
+	ret_val=group_solve(env,warm);
+	stopped=solve_group_end();
+	if(paused)
+		*paused=(ret_val==TM_SIGNAL_CAUGHT && stopped==SOLVE_SLICE_OVER);
+	return ret_val;
+}
+
+/* Solves the problem in env, from its warm start if warm is nonzero
+ * Ctrl-C stops the solve with TM_SIGNAL_CAUGHT, keeping the best solution found so far
+ * Returns the return value of symphony
+ */
+int interruptible_solve(sym_environment *env, int warm){
+	return sliced_solve(env,warm,-1,NULL);
+}
+
 }
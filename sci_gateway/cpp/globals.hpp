@@ -0,0 +1,50 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for running solves, defined in globals.cpp
+// Symphony keeps the state of a solve in its environment, except for c_count, which stops every running
+// solve when it becomes positive, and the SIGINT handler that it installs when a solve starts. Both belong
+// to one group of solves at a time: a solve started from Scilab, the solves that sym_sweep and
+// sym_solveBlocks run on several threads at once, or the background solve of sym_solveAsync. Solves of
+// different environments in the same group may run at the same time; a group started while another one
+// runs waits for it to finish.
+
+#ifndef SCI_SYMGLOBALSHEADER
+#define SCI_SYMGLOBALSHEADER
+
+#include "symphony.h"
+
+//how a group of solves was stopped
+#define SOLVE_NOT_STOPPED 0
+#define SOLVE_INTERRUPTED 1	//by Ctrl-C
+#define SOLVE_SLICE_OVER 2	//by the end of its slice of time
+#define SOLVE_CANCELLED 3	//by its stop flag
+
+extern "C" {
+
+//print the meaning of a return value of symphony, returns 1 if it is an error
+int process_ret_val(int ret_val);
+
+//start a group of solves, which the end of a slice of seconds stops if seconds is not negative
+//without a stop flag Ctrl-C stops the group; with one, the group runs in the background, Ctrl-C is left
+//to Scilab and the group stops once *stop is nonzero
+void solve_group_begin(double seconds, volatile int *stop);
+
+//solve env in the current group, from its warm start if warm is nonzero, returns the return value of symphony
+//once the group is stopping no solve is started, and TM_SIGNAL_CAUGHT is returned
+int group_solve(sym_environment *env, int warm);
+
+//whether the current group has been asked to stop
+int solve_group_stopping();
+
+//end the current group, returns SOLVE_NOT_STOPPED, SOLVE_INTERRUPTED, SOLVE_SLICE_OVER or SOLVE_CANCELLED
+int solve_group_end();
+
+//solve env alone, for at most seconds if it is not negative; paused, if not NULL, is set to 1
+//if the solve was stopped by the end of the slice and not by Ctrl-C
+int sliced_solve(sym_environment *env, int warm, double seconds, int *paused);
+
+//solve env alone, Ctrl-C stops it and keeps the best solution found so far
+int interruptible_solve(sym_environment *env, int warm);
+
+}
+
+#endif //SCI_SYMGLOBALSHEADER
@@ -5,6 +5,7 @@
  */
 #include "symphony.h"
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
 
 extern sym_environment* global_sym_env; //defined in globals.cpp
 
@@ -15,6 +16,20 @@ extern "C" {
 #include "BOOL.h"
 #include <localization.h>
 
+//get input argNum as a vector of size values, given either as a row or as a column
+static int getVectorFromScilab(int argNum, int size, double **dest)
+{
+	int rows,cols;
+	if(getDoubleMatrixFromScilab(argNum,&rows,&cols,dest))
+		return 1;
+	if(rows*cols!=size || (rows!=1 && cols!=1 && size!=0))
+	{
+		Scierror(999, "Wrong size for input argument #%d: A vector of %d values is expected.\n",argNum,size);
+		return 1;
+	}
+	return 0;
+}
+
 int sci_sym_addConstr(char *fname){
 	
 	//error management variable
@@ -32,6 +47,8 @@ int sci_sym_addConstr(char *fname){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 		return 1;
 	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
 	
 	//code to check arguments and get them
 	CheckInputArgument(pvApiCtx,3,4) ;
@@ -169,6 +186,8 @@ int sci_sym_addVar(char *fname){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 		return 1;
 	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
 	
 	//code to check arguments and get them
 	CheckInputArgument(pvApiCtx,6,6) ;
@@ -278,4 +297,249 @@ int sci_sym_addVar(char *fname){
 	return 0;
 }
 
+int sci_sym_addConstrs(char *fname){
+	
+	//error management variable
+	SciErr sciErr;
+	int iRet;
+	
+	//data declarations
+	int *varAddress,numVars,nonZeros,*itemsPerRow,*colIndex,*symColIndex,inputRows,inputCols,rowIter,arrayIter;
+	double *matrix,*conLower,*conUpper,conRHS,conRange;
+	char conType;
+	
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+	
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,3,3) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+	
+	//get number of columns
+	iRet=sym_get_num_cols(global_sym_env,&numVars);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+	
+	//get input 1: sparse matrix of variable coefficients, one row per new constraint
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isSparseType(pvApiCtx,varAddress) ||  isVarComplex(pvApiCtx,varAddress) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A sparse matrix of doubles is expected.\n");
+		return 1;
+	}
+	sciErr = getSparseMatrix(pvApiCtx,varAddress,&inputRows,&inputCols,&nonZeros,&itemsPerRow,&colIndex,&matrix);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(inputCols!=numVars)
+	{
+		Scierror(999, "Wrong type for input argument #1: Incorrectly sized matrix.\n");
+		return 1;
+	}
+	
+	//get input 2: lower bounds of the new constraints
+	if(getVectorFromScilab(2,inputRows,&conLower))
+		return 1;
+	
+	//get input 3: upper bounds of the new constraints
+	if(getVectorFromScilab(3,inputRows,&conUpper))
+		return 1;
+	for(rowIter=0;rowIter<inputRows;rowIter++)
+		if(conLower[rowIter]>conUpper[rowIter])
+		{
+			Scierror(999, "Error: the lower bound of constraint %d is more than its upper bound.\n",rowIter);
+			return 1;
+		}
+	
+	//scilab has 1-based column indices, convert to 0-based for Symphony
+	//scilab stores sparse matrices row by row, so each row can then be passed to Symphony as it is
+	symColIndex=new int[nonZeros];
+	for(arrayIter=0;arrayIter<nonZeros;arrayIter++)
+		symColIndex[arrayIter]=colIndex[arrayIter]-1;
+	
+	for(rowIter=0,arrayIter=0,iRet=0;rowIter<inputRows && iRet!=FUNCTION_TERMINATED_ABNORMALLY;rowIter++)
+	{
+		//deduce type of constraint, as in sym_loadProblem
+		conRange=0;
+		if(conLower[rowIter]==(-INFINITY) && conUpper[rowIter]==INFINITY){
+			conType='N';
+			conRHS=0;
+		}else if(conLower[rowIter]==(-INFINITY)){
+			conType='L';
+			conRHS=conUpper[rowIter];
+		}else if(conUpper[rowIter]==INFINITY){
+			conType='G';
+			conRHS=conLower[rowIter];
+		}else if(conUpper[rowIter]==conLower[rowIter]){
+			conType='E';
+			conRHS=conLower[rowIter];
+		}else{
+			conType='R';
+			conRange=conUpper[rowIter]-conLower[rowIter];
+			conRHS=conUpper[rowIter];
+		}
+		iRet=sym_add_row(global_sym_env,itemsPerRow[rowIter],symColIndex+arrayIter,matrix+arrayIter,conType,conRHS,conRange);
+		arrayIter+=itemsPerRow[rowIter];
+	}
+	delete[] symColIndex;
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured.\n");
+		return 1;
+	}else{
+		sciprint("%d constraints successfully added.\n",inputRows);
+	}
+	
+	//code to give output
+	if(return0toScilab())
+		return 1;
+	
+	return 0;
+}
+
+int sci_sym_addVars(char *fname){
+	
+	//error management variable
+	SciErr sciErr;
+	int iRet;
+	
+	//data declarations
+	int *varAddress,numConstr,nonZeros,*itemsPerRow,*colIndex,inputRows,inputCols,rowIter,colIter,arrayIter,*isIntBool;
+	int *colStart,*rowIndex,*nextInCol;
+	double *matrix,*colValue,*lBound,*uBound,*objCoeff;
+	
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+	
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,5,5) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+	
+	//get number of rows
+	iRet=sym_get_num_rows(global_sym_env,&numConstr);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+	
+	//get input 1: sparse matrix of constraint coefficients, one column per new variable
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isSparseType(pvApiCtx,varAddress) ||  isVarComplex(pvApiCtx,varAddress) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A sparse matrix of doubles is expected.\n");
+		return 1;
+	}
+	sciErr = getSparseMatrix(pvApiCtx,varAddress,&inputRows,&inputCols,&nonZeros,&itemsPerRow,&colIndex,&matrix);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(inputRows!=numConstr)
+	{
+		Scierror(999, "Wrong type for input argument #1: Incorrectly sized matrix.\n");
+		return 1;
+	}
+	
+	//get input 2: lower bounds of the new variables
+	if(getVectorFromScilab(2,inputCols,&lBound))
+		return 1;
+	
+	//get input 3: upper bounds of the new variables
+	if(getVectorFromScilab(3,inputCols,&uBound))
+		return 1;
+	
+	//get input 4: coefficients of the new variables in objective
+	if(getVectorFromScilab(4,inputCols,&objCoeff))
+		return 1;
+	
+	//get input 5: wether each variable is constrained to be an integer
+	sciErr = getVarAddressFromPosition(pvApiCtx, 5, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isBooleanType(pvApiCtx, varAddress) )
+	{
+		Scierror(999, "Wrong type for input argument #5: A matrix of booleans is expected.\n");
+		return 1;
+	}
+	sciErr = getMatrixOfBoolean(pvApiCtx, varAddress, &rowIter, &colIter, &isIntBool);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(rowIter*colIter!=inputCols || (rowIter!=1 && colIter!=1 && inputCols!=0))
+	{
+		Scierror(999, "Wrong size for input argument #5: A vector of %d booleans is expected.\n",inputCols);
+		return 1;
+	}
+	
+	//convert the row-major block to column-major form once, in linear time
+	colStart=new int[inputCols+1];
+	nextInCol=new int[inputCols];
+	rowIndex=new int[nonZeros];
+	colValue=new double[nonZeros];
+	for(colIter=0;colIter<=inputCols;colIter++)
+		colStart[colIter]=0;
+	for(arrayIter=0;arrayIter<nonZeros;arrayIter++)
+		colStart[colIndex[arrayIter]]++; //scilab column indices are 1-based
+	for(colIter=0;colIter<inputCols;colIter++)
+	{
+		colStart[colIter+1]+=colStart[colIter];
+		nextInCol[colIter]=colStart[colIter];
+	}
+	for(rowIter=0,arrayIter=0;rowIter<numConstr;rowIter++)
+		for(colIter=0;colIter<itemsPerRow[rowIter];colIter++,arrayIter++)
+		{
+			rowIndex[nextInCol[colIndex[arrayIter]-1]]=rowIter;
+			colValue[nextInCol[colIndex[arrayIter]-1]++]=matrix[arrayIter];
+		}
+	
+	for(colIter=0,iRet=0;colIter<inputCols && iRet!=FUNCTION_TERMINATED_ABNORMALLY;colIter++)
+		iRet=sym_add_col(global_sym_env,colStart[colIter+1]-colStart[colIter],rowIndex+colStart[colIter],colValue+colStart[colIter],
+			lBound[colIter],uBound[colIter],objCoeff[colIter],isIntBool[colIter]?TRUE:FALSE,NULL);
+	delete[] colStart;
+	delete[] nextInCol;
+	delete[] rowIndex;
+	delete[] colValue;
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured.\n");
+		return 1;
+	}else{
+		sciprint("%d variables successfully added.\n",inputCols);
+	}
+	
+	//code to give output
+	if(return0toScilab())
+		return 1;
+	
+	return 0;
+}
+
 }
@@ -0,0 +1,328 @@
+/*
+ * Symphony Toolbox
+ * Profile of the loaded problem, and the parameters recommended for it
+ * The profile is made in one pass over the columns of the matrix; the kinds of rows found decide which
+ * cut generators and which node selection rule are recommended
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include <sys/time.h>
+#include <string>
+#include <vector>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <math.h>
+}
+
+//a binary variable with a coefficient this many times the smallest coefficient of a continuous or general
+//integer variable in the same row makes a big-M row
+#define BIG_M_RATIO 1e3
+
+//share of the rows of a kind from which the cut generators for that kind are recommended
+#define ROW_KIND_SHARE 0.1
+
+//values of the cut generator parameters, as sym_setCuts sets them
+#define CUTS_IF_ROOT 1
+#define CUTS_ALWAYS 3
+
+//what is known of a row after the pass over the columns
+struct rowProfile{
+	int numElements;
+	bool allBinary,allOne,nonNegative;
+	double maxBinary,minOther;	//largest coefficient of a binary, smallest of another variable, in absolute value
+};
+
+//the smallest and largest of the values given to it
+struct valueRange{
+	double min,max;
+	valueRange():min(INFINITY),max(-INFINITY){}
+	void add(double value){
+		if(value<min) min=value;
+		if(value>max) max=value;
+	}
+	std::vector<double> values() const{
+		std::vector<double> range(2,NAN);
+		if(min<=max){
+			range[0]=min;
+			range[1]=max;
+		}
+		return range;
+	}
+};
+
+//a recommended parameter and the reason for it
+struct recommendation{
+	const char *param;
+	int value;
+	std::string reason;
+};
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+static std::string percentOf(int count, int total)
+{
+	char text[64];
+	snprintf(text,sizeof(text),"%d rows, %.0f%%",count,total?100.0*count/total:0.0);
+	return text;
+}
+
+//the minimum, mean and maximum of counts
+static std::vector<double> countSummary(const std::vector<int> &counts)
+{
+	std::vector<double> summary(3,0);
+	size_t iter;
+	if(counts.empty())
+		return summary;
+	summary[0]=summary[2]=counts[0];
+	for(iter=0;iter<counts.size();iter++){
+		if(counts[iter]<summary[0]) summary[0]=counts[iter];
+		if(counts[iter]>summary[2]) summary[2]=counts[iter];
+		summary[1]+=counts[iter];
+	}
+	summary[1]/=counts.size();
+	return summary;
+}
+
+extern "C" {
+
+int sci_sym_analyze(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int numCols,numRows,numElements,col,row,iter,*listAddress,dims[2]={1,1};
+	int numBinary=0,numInteger=0,numEquality=0,setPacking=0,setPartitioning=0,knapsack=0,bigM=0;
+	double apply=0,startTime=wallClock(),infinity=sym_get_infinity();
+	char isInt;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,1) ;
+	CheckOutputArgument(pvApiCtx,1,3) ;
+
+	//get input 1: whether the recommended parameters are set, 0 by default
+	if(nbInputArgument(pvApiCtx)==1 && getDoubleFromScilab(1,&apply))
+		return 1;
+
+	if(sym_get_num_cols(global_sym_env,&numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(global_sym_env,&numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(global_sym_env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+	std::vector<int> colStart(numCols+1),rowIndex(numElements+1);
+	std::vector<double> value(numElements+1),lower(numCols+1),upper(numCols+1),objective(numCols+1);
+	std::vector<double> rowLower(numRows+1),rowUpper(numRows+1);
+	if(sym_get_matrix(global_sym_env,&numElements,&colStart[0],&rowIndex[0],&value[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_lower(global_sym_env,&lower[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_upper(global_sym_env,&upper[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_coeff(global_sym_env,&objective[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		(numRows && sym_get_row_lower(global_sym_env,&rowLower[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(numRows && sym_get_row_upper(global_sym_env,&rowUpper[0])==FUNCTION_TERMINATED_ABNORMALLY)){
+		Scierror(999, "An error occured while getting the problem from Symphony.\n");
+		return 1;
+	}
+
+	//the pass over the columns: the columns are profiled, the rows collect what they need to be classified
+	rowProfile empty={0,true,true,true,0,INFINITY};
+	std::vector<rowProfile> rows(numRows,empty);
+	std::vector<int> colCounts(numCols),rowCounts(numRows);
+	valueRange coefRange,objRange,boundRange,rhsRange;
+	for(col=0;col<numCols;col++){
+		bool binary;
+		sym_is_integer(global_sym_env,col,&isInt);
+		binary=isInt && lower[col]>=0 && upper[col]<=1;
+		if(binary)
+			numBinary++;
+		else if(isInt)
+			numInteger++;
+		if(objective[col]!=0)
+			objRange.add(fabs(objective[col]));
+		if(lower[col]!=0 && fabs(lower[col])<infinity)
+			boundRange.add(fabs(lower[col]));
+		if(upper[col]!=0 && fabs(upper[col])<infinity)
+			boundRange.add(fabs(upper[col]));
+		colCounts[col]=colStart[col+1]-colStart[col];
+		for(iter=colStart[col];iter<colStart[col+1];iter++){
+			rowProfile &profile=rows[rowIndex[iter]];
+			double coef=fabs(value[iter]);
+			if(coef==0)
+				continue;
+			coefRange.add(coef);
+			profile.numElements++;
+			profile.allOne=profile.allOne && value[iter]==1;
+			profile.nonNegative=profile.nonNegative && value[iter]>0;
+			if(binary){
+				if(coef>profile.maxBinary)
+					profile.maxBinary=coef;
+			}else{
+				profile.allBinary=false;
+				if(coef<profile.minOther)
+					profile.minOther=coef;
+			}
+		}
+	}
+
+	//the kinds of rows
+	for(row=0;row<numRows;row++){
+		const rowProfile &profile=rows[row];
+		bool noLower=rowLower[row]<=-infinity,noUpper=rowUpper[row]>=infinity;
+		rowCounts[row]=profile.numElements;
+		if(!noLower && rowLower[row]!=0)
+			rhsRange.add(fabs(rowLower[row]));
+		if(!noUpper && rowUpper[row]!=0)
+			rhsRange.add(fabs(rowUpper[row]));
+		if(!noLower && rowLower[row]==rowUpper[row])
+			numEquality++;
+		if(profile.numElements<2)
+			continue;
+		if(profile.allBinary && profile.allOne && rowUpper[row]==1 && rowLower[row]==1)
+			setPartitioning++;
+		else if(profile.allBinary && profile.allOne && rowUpper[row]==1 && (noLower || rowLower[row]<=0))
+			setPacking++;
+		else if(profile.allBinary && profile.nonNegative && !noUpper && noLower)
+			knapsack++;
+		else if(profile.maxBinary>0 && profile.minOther<INFINITY && profile.maxBinary>=BIG_M_RATIO*profile.minOther)
+			bigM++;
+	}
+
+	//the recommendations, from the kinds of rows and variables found
+	std::vector<recommendation> recommended;
+	int numIntegral=numBinary+numInteger;
+	if(numIntegral>0){
+		if(setPacking+setPartitioning>0 && setPacking+setPartitioning>=ROW_KIND_SHARE*numRows){
+			recommendation clique={"generate_cgl_clique_cuts",CUTS_ALWAYS,"set packing and partitioning rows: "+percentOf(setPacking+setPartitioning,numRows)};
+			recommended.push_back(clique);
+		}
+		if(knapsack>0 && knapsack>=ROW_KIND_SHARE*numRows){
+			recommendation cover={"generate_cgl_knapsack_cuts",CUTS_ALWAYS,"knapsack rows: "+percentOf(knapsack,numRows)};
+			recommended.push_back(cover);
+		}
+		if(bigM>0){
+			recommendation flow={"generate_cgl_flowcover_cuts",CUTS_ALWAYS,"big-M rows: "+percentOf(bigM,numRows)};
+			recommended.push_back(flow);
+		}
+		if(numInteger>=0.3*numIntegral){
+			recommendation gomory={"generate_cgl_gomory_cuts",CUTS_ALWAYS,"general integer variables"};
+			recommendation mir={"generate_cgl_mir_cuts",CUTS_ALWAYS,"general integer variables"};
+			recommended.push_back(gomory);
+			recommended.push_back(mir);
+		}
+		if(numBinary==numCols){
+			recommendation probing={"generate_cgl_probing_cuts",CUTS_IF_ROOT,"all variables are binary"};
+			recommended.push_back(probing);
+		}
+		//equality rows make feasible solutions hard to find, diving finds a first one sooner
+		if(numEquality>=0.5*numRows && numRows>0){
+			recommendation dive={"node_selection_rule",DEPTH_FIRST_THEN_BEST_FIRST,"equality rows: "+percentOf(numEquality,numRows)};
+			recommended.push_back(dive);
+		}else{
+			recommendation best={"node_selection_rule",LOWEST_LP_FIRST,"feasible solutions are expected to be easy to find"};
+			recommended.push_back(best);
+		}
+		recommendation cuts={"generate_cgl_cuts",TRUE,"cut generation is needed for the generators above"};
+		if(recommended.size()>1)
+			recommended.push_back(cuts);
+	}else{
+		recommendation noCuts={"generate_cgl_cuts",FALSE,"there are no integer variables"};
+		recommended.push_back(noCuts);
+	}
+	double elapsed=wallClock()-startTime;
+
+	sciprint("Problem analysed in %.3f ms: %d variables (%d binary, %d general integer), %d constraints, %d nonzeros.\n",
+		elapsed*1000,numCols,numBinary,numInteger,numRows,numElements);
+	for(iter=0;iter<(int)recommended.size();iter++){
+		sciprint("%s %s = %d (%s)\n",apply!=0?"Setting":"Recommended:",recommended[iter].param,recommended[iter].value,recommended[iter].reason.c_str());
+		if(apply!=0 && sym_set_int_param(global_sym_env,recommended[iter].param,recommended[iter].value)==FUNCTION_TERMINATED_ABNORMALLY){
+			Scierror(999, "An error occured while setting the parameter %s.\n",recommended[iter].param);
+			return 1;
+		}
+	}
+
+	//code to give output 1: the profile, as a structure
+	std::vector<std::pair<const char*,std::vector<double> > > fields;
+	fields.push_back(std::make_pair("numVar",std::vector<double>(1,numCols)));
+	fields.push_back(std::make_pair("numConstr",std::vector<double>(1,numRows)));
+	fields.push_back(std::make_pair("numElements",std::vector<double>(1,numElements)));
+	fields.push_back(std::make_pair("density",std::vector<double>(1,(numRows && numCols)?(double)numElements/numRows/numCols:0)));
+	fields.push_back(std::make_pair("rowNnz",countSummary(rowCounts)));
+	fields.push_back(std::make_pair("colNnz",countSummary(colCounts)));
+	fields.push_back(std::make_pair("coefRange",coefRange.values()));
+	fields.push_back(std::make_pair("objRange",objRange.values()));
+	fields.push_back(std::make_pair("boundRange",boundRange.values()));
+	fields.push_back(std::make_pair("rhsRange",rhsRange.values()));
+	fields.push_back(std::make_pair("numBinary",std::vector<double>(1,numBinary)));
+	fields.push_back(std::make_pair("numInteger",std::vector<double>(1,numInteger)));
+	fields.push_back(std::make_pair("numContinuous",std::vector<double>(1,numCols-numIntegral)));
+	fields.push_back(std::make_pair("binaryShare",std::vector<double>(1,numCols?(double)numBinary/numCols:0)));
+	fields.push_back(std::make_pair("integerShare",std::vector<double>(1,numCols?(double)numInteger/numCols:0)));
+	fields.push_back(std::make_pair("numEquality",std::vector<double>(1,numEquality)));
+	fields.push_back(std::make_pair("setPacking",std::vector<double>(1,setPacking)));
+	fields.push_back(std::make_pair("setPartitioning",std::vector<double>(1,setPartitioning)));
+	fields.push_back(std::make_pair("knapsack",std::vector<double>(1,knapsack)));
+	fields.push_back(std::make_pair("bigM",std::vector<double>(1,bigM)));
+	fields.push_back(std::make_pair("time",std::vector<double>(1,elapsed)));
+	std::vector<const char*> fieldNames(1,"st");
+	fieldNames.push_back("dims");
+	for(iter=0;iter<(int)fields.size();iter++)
+		fieldNames.push_back(fields[iter].first);
+	sciErr=createMList(pvApiCtx,nbInputArgument(pvApiCtx)+1,fieldNames.size(),&listAddress);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfStringInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,1,1,fieldNames.size(),&fieldNames[0]);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfInteger32InList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,2,1,2,dims);
+	for(iter=0;iter<(int)fields.size() && !sciErr.iErr;iter++)
+		sciErr=createMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,iter+3,1,fields[iter].second.size(),&fields[iter].second[0]);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	//code to give outputs 2 and 3: the names and values of the recommended parameters
+	if(nbOutputArgument(pvApiCtx)>=2){
+		std::vector<const char*> names;
+		std::vector<double> values;
+		for(iter=0;iter<(int)recommended.size();iter++){
+			names.push_back(recommended[iter].param);
+			values.push_back(recommended[iter].value);
+		}
+		sciErr=createMatrixOfString(pvApiCtx,nbInputArgument(pvApiCtx)+2,names.size(),1,&names[0]);
+		if(!sciErr.iErr)
+			sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+3,values.size(),1,&values[0]);
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			return 1;
+		}
+		AssignOutputVariable(pvApiCtx,2)=nbInputArgument(pvApiCtx)+2;
+		if(nbOutputArgument(pvApiCtx)==3)
+			AssignOutputVariable(pvApiCtx,3)=nbInputArgument(pvApiCtx)+3;
+	}
+
+	return 0;
+}
+
+}
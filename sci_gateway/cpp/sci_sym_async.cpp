@@ -0,0 +1,245 @@
+/*
+ * Symphony Toolbox
+ * Functions for solving in the background: start a solve, poll it, cancel it and wait for it
+ * While the solve runs, the environment is detached from Scilab so that a new one can be opened
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_progress.hpp"
+#include "sci_sym_presolve.hpp"
+#include "globals.hpp"
+#include <pthread.h>
+#include <sys/time.h>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <math.h>
+#include <string.h>
+
+void modelCacheForget(sym_environment *env); //defined in sci_sym_model_cache.cpp
+void forgetEnvironment(sym_environment *env); //defined in sci_sym_openclose.cpp
+
+//state of the background solve
+#define ASYNC_NONE 0
+#define ASYNC_RUNNING 1
+#define ASYNC_FINISHED 2
+
+static sym_environment *asyncEnv=NULL;
+static pthread_t asyncThread;
+static pthread_mutex_t asyncMutex=PTHREAD_MUTEX_INITIALIZER;
+static int asyncState=ASYNC_NONE,asyncStatus;
+static volatile int asyncCancel=0;	//the stop flag of the background solve, set by sym_cancel()
+static double asyncStart,asyncEnd;
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+static void *asyncSolve(void *arg)
+{
+	//the solve is a group of its own, which Ctrl-C in Scilab does not stop
+	solve_group_begin(-1,&asyncCancel);
+	int status=group_solve(asyncEnv,0);
+	solve_group_end();
+	pthread_mutex_lock(&asyncMutex);
+	asyncStatus=status;
+	asyncEnd=wallClock();
+	asyncState=ASYNC_FINISHED;
+	pthread_mutex_unlock(&asyncMutex);
+	return NULL;
+}
+
+int sci_sym_solveAsync(char *fname){
+
+	//check whether we have no input and one output argument or not
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(asyncState!=ASYNC_NONE){
+		Scierror(999, "A background solve is already running or has not been collected. Please run 'sym_wait()' first.\n");
+		return 1;
+	}
+
+	//the environment belongs to the solver thread until sym_wait() is called, so the model cache must not hand it out
+	modelCacheForget(global_sym_env);
+	asyncEnv=global_sym_env;
+	global_sym_env=NULL;
+	asyncCancel=0;
+	asyncStart=wallClock();
+	asyncState=ASYNC_RUNNING;
+	//the output of the solver is not captured: Scilab keeps writing to the console while the solve runs
+	progressSkip();
+	if(pthread_create(&asyncThread,NULL,asyncSolve,NULL)){
+		global_sym_env=asyncEnv;
+		asyncEnv=NULL;
+		asyncState=ASYNC_NONE;
+		Scierror(999, "Unable to start the background solve.\n");
+		return 1;
+	}
+	sciprint("Solve started in the background. Use 'sym_poll()' and 'sym_wait()' to follow it.\n");
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_poll(char *fname){
+
+	//data declarations
+	double results[5]; //state, incumbent, bound, nodes, elapsed time
+	int iter;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,5) ;
+
+	results[1]=results[2]=results[3]=NAN;
+	results[4]=0;
+	pthread_mutex_lock(&asyncMutex);
+	results[0]=asyncState;
+	//while running, the environment belongs to the solver thread and only the elapsed time is known
+	if(asyncState==ASYNC_RUNNING)
+		results[4]=wallClock()-asyncStart;
+	else if(asyncState==ASYNC_FINISHED)
+		results[4]=asyncEnd-asyncStart;
+	pthread_mutex_unlock(&asyncMutex);
+
+	//once the thread is done, the environment can be queried safely
+	if(results[0]==ASYNC_FINISHED){
+		int nodes;
+		if(sym_get_obj_val(asyncEnv,&results[1])==FUNCTION_TERMINATED_ABNORMALLY)
+			results[1]=NAN;
+		else if(asyncStatus==TM_OPTIMAL_SOLUTION_FOUND || asyncStatus==PREP_OPTIMAL_SOLUTION_FOUND)
+			results[2]=results[1];
+		if(sym_get_iteration_count(asyncEnv,&nodes)!=FUNCTION_TERMINATED_ABNORMALLY)
+			results[3]=nodes;
+	}
+
+	//code to give output
+	for(iter=0;iter<nbOutputArgument(pvApiCtx) && iter<5;iter++){
+		if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+iter+1,results[iter])){
+			AssignOutputVariable(pvApiCtx,1)=0;
+			return 1;
+		}
+		AssignOutputVariable(pvApiCtx,iter+1)=nbInputArgument(pvApiCtx)+iter+1;
+	}
+
+	return 0;
+}
+
+int sci_sym_cancel(char *fname){
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	pthread_mutex_lock(&asyncMutex);
+	if(asyncState==ASYNC_RUNNING){
+		//the solver is stopped between nodes with TM_SIGNAL_CAUGHT, keeping the incumbent
+		asyncCancel=1;
+		sciprint("The background solve has been asked to stop. Use 'sym_wait()' to collect the result.\n");
+	}else
+		sciprint("No background solve is running.\n");
+	pthread_mutex_unlock(&asyncMutex);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_wait(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int status,numVars;
+	double objVal,*solution=NULL;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,3) ;
+
+	if(asyncState==ASYNC_NONE){
+		Scierror(999, "No background solve has been started. Please run 'sym_solveAsync()' first.\n");
+		return 1;
+	}
+	pthread_join(asyncThread,NULL);
+	status=process_ret_val(asyncStatus);
+
+	//collect the solution before the environment may be closed, in terms of the original problem if it was presolved
+	objVal=NAN;
+	int numConstr,restoredState;
+	const double *restored,*rowAct;
+	restoredState=presolveRestoreSolution(asyncEnv,&numVars,&numConstr,&restored,&rowAct,&objVal);
+	if(restoredState>0){
+		solution=new double[numVars];
+		memcpy(solution,restored,numVars*sizeof(double));
+	}else if(restoredState<0)
+		objVal=NAN;
+	else if(sym_get_num_cols(asyncEnv,&numVars)!=FUNCTION_TERMINATED_ABNORMALLY){
+		solution=new double[numVars];
+		if(sym_get_col_solution(asyncEnv,solution)==FUNCTION_TERMINATED_ABNORMALLY ||
+			sym_get_obj_val(asyncEnv,&objVal)==FUNCTION_TERMINATED_ABNORMALLY){
+			delete[] solution;
+			solution=NULL;
+			objVal=NAN;
+		}
+	}
+
+	//give the environment back to Scilab, unless a new one has been opened in the meantime
+	if(global_sym_env==NULL)
+		global_sym_env=asyncEnv;
+	else{
+		forgetEnvironment(asyncEnv);
+		sym_close_environment(asyncEnv);
+	}
+	asyncEnv=NULL;
+	asyncState=ASYNC_NONE;
+
+	//code to give output
+	if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,status)){
+		if(solution) delete[] solution;
+		AssignOutputVariable(pvApiCtx,1)=0;
+		return 1;
+	}
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+	if(nbOutputArgument(pvApiCtx)>=2){
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,solution?1:0,solution?numVars:0,solution);
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			if(solution) delete[] solution;
+			return 1;
+		}
+		AssignOutputVariable(pvApiCtx,2)=nbInputArgument(pvApiCtx)+2;
+	}
+	if(solution) delete[] solution;
+	if(nbOutputArgument(pvApiCtx)>=3){
+		if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+3,objVal))
+			return 1;
+		AssignOutputVariable(pvApiCtx,3)=nbInputArgument(pvApiCtx)+3;
+	}
+
+	return 0;
+}
+
+}
@@ -0,0 +1,467 @@
+/*
+ * Symphony Toolbox
+ * Finding the independent blocks of the loaded problem and solving each of them in its own environment
+ * The blocks are solved on several threads and their solutions are merged into a solution of the whole problem
+ * The threads solve in one group, see globals.hpp, so Ctrl-C stops all of them
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_blocks.hpp"
+#include "globals.hpp"
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <math.h>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+}
+
+static int findRoot(std::vector<int> &parent, int node)
+{
+	while(parent[node]!=node){
+		parent[node]=parent[parent[node]];
+		node=parent[node];
+	}
+	return node;
+}
+
+int blocksFind(int numCols, int numRows, const int *colStart, const int *rowIndex,
+	std::vector<int> &colBlock, std::vector<int> &rowBlock)
+{
+	std::vector<int> parent(numCols),firstCol(numRows,-1),label(numCols,-1);
+	int col,row,index,numBlocks=0,freeBlock=-1;
+	for(col=0;col<numCols;col++)
+		parent[col]=col;
+	//union the columns of each row with the first column seen in it
+	for(col=0;col<numCols;col++)
+		for(index=colStart[col];index<colStart[col+1];index++){
+			row=rowIndex[index];
+			if(firstCol[row]<0)
+				firstCol[row]=col;
+			else{
+				int first=findRoot(parent,firstCol[row]),second=findRoot(parent,col);
+				if(first!=second)
+					parent[second]=first;
+			}
+		}
+
+	colBlock.assign(numCols,-1);
+	rowBlock.assign(numRows,-1);
+	for(col=0;col<numCols;col++){
+		if(colStart[col]==colStart[col+1])
+			continue;
+		int root=findRoot(parent,col);
+		if(label[root]<0)
+			label[root]=numBlocks++;
+		colBlock[col]=label[root];
+	}
+	for(row=0;row<numRows;row++)
+		if(firstCol[row]>=0)
+			rowBlock[row]=colBlock[firstCol[row]];
+	for(col=0;col<numCols;col++)
+		if(colBlock[col]<0){
+			if(freeBlock<0)
+				freeBlock=numBlocks++;
+			colBlock[col]=freeBlock;
+		}
+	for(row=0;row<numRows;row++)
+		if(rowBlock[row]<0){
+			if(freeBlock<0)
+				freeBlock=numBlocks++;
+			rowBlock[row]=freeBlock;
+		}
+	return numBlocks;
+}
+
+//parameters given to the environment of each block, those that are not set in the main environment are left alone
+static const char *blockIntParams[]={"node_limit","find_first_feasible","node_selection_rule","diving_strategy",
+	"generate_cgl_cuts","generate_cgl_gomory_cuts","generate_cgl_knapsack_cuts","generate_cgl_oddhole_cuts",
+	"generate_cgl_clique_cuts","generate_cgl_probing_cuts","generate_cgl_mir_cuts","generate_cgl_twomir_cuts",
+	"generate_cgl_flowcover_cuts","generate_cgl_rounding_cuts","generate_cgl_lift_and_project_cuts",
+	"generate_cgl_landp_cuts","generate_cgl_redsplit_cuts",NULL};
+static const char *blockDblParams[]={"time_limit","gap_limit","granularity",NULL};
+
+//a block and, once it is solved, its result
+struct blockWork{
+	std::vector<int> cols,rows;
+	int status;
+	bool hasSolution;
+	double objVal;
+	std::vector<double> solution;
+};
+
+//the whole problem as symphony holds it, shared by the threads
+struct blocksJob{
+	int numCols,numRows,objSense;
+	std::vector<int> colStart,rowIndex,rowLocal;	//rowLocal: position of each row in its block
+	std::vector<double> value,lower,upper,objective,rowRHS,rowRange;
+	std::vector<char> isInt,rowSense;
+	std::vector<int> intParams;
+	std::vector<double> dblParams;
+	std::vector<bool> hasIntParam,hasDblParam;
+	std::vector<blockWork> blocks;
+	size_t next;
+	pthread_mutex_t lock;
+};
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+static void solveBlock(blocksJob *job, blockWork *block)
+{
+	int numCols=block->cols.size(),numRows=block->rows.size(),iter,index;
+	std::vector<int> colStart(numCols+1),rowIndex;
+	std::vector<double> value,lower(numCols+1),upper(numCols+1),objective(numCols+1),rowRHS(numRows+1),rowRange(numRows+1);
+	std::vector<char> isInt(numCols+1),rowSense(numRows+1);
+	sym_environment *env;
+
+	for(iter=0;iter<numCols;iter++){
+		int col=block->cols[iter];
+		colStart[iter]=rowIndex.size();
+		for(index=job->colStart[col];index<job->colStart[col+1];index++){
+			rowIndex.push_back(job->rowLocal[job->rowIndex[index]]);
+			value.push_back(job->value[index]);
+		}
+		lower[iter]=job->lower[col];
+		upper[iter]=job->upper[col];
+		objective[iter]=job->objective[col];
+		isInt[iter]=job->isInt[col];
+	}
+	colStart[numCols]=rowIndex.size();
+	rowIndex.push_back(0);
+	value.push_back(0);
+	for(iter=0;iter<numRows;iter++){
+		rowSense[iter]=job->rowSense[block->rows[iter]];
+		rowRHS[iter]=job->rowRHS[block->rows[iter]];
+		rowRange[iter]=job->rowRange[block->rows[iter]];
+	}
+
+	env=sym_open_environment();
+	block->hasSolution=false;
+	block->status=TM_NO_PROBLEM;
+	if(env==NULL)
+		return;
+	for(iter=0;blockIntParams[iter];iter++)
+		if(job->hasIntParam[iter])
+			sym_set_int_param(env,blockIntParams[iter],job->intParams[iter]);
+	for(iter=0;blockDblParams[iter];iter++)
+		if(job->hasDblParam[iter])
+			sym_set_dbl_param(env,blockDblParams[iter],job->dblParams[iter]);
+	//the blocks are solved at the same time, their output would be mixed
+	sym_set_int_param(env,"verbosity",-2);
+	sym_explicit_load_problem(env,numCols,numRows,&colStart[0],&rowIndex[0],&value[0],&lower[0],&upper[0],
+		&isInt[0],&objective[0],NULL,&rowSense[0],&rowRHS[0],&rowRange[0],TRUE);
+	sym_set_obj_sense(env,job->objSense);
+	block->status=group_solve(env,0);
+	block->solution.resize(numCols+1);
+	block->hasSolution=sym_get_col_solution(env,&block->solution[0])!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_obj_val(env,&block->objVal)!=FUNCTION_TERMINATED_ABNORMALLY;
+	sym_close_environment(env);
+}
+
+//the columns in no row take their best bound, the rows with no column only need 0 to satisfy them
+static void solveFreeBlock(blocksJob *job, blockWork *block)
+{
+	double infinity=sym_get_infinity();
+	size_t iter;
+	block->status=TM_OPTIMAL_SOLUTION_FOUND;
+	block->hasSolution=true;
+	block->objVal=0;
+	block->solution.assign(block->cols.size()+1,0.0);
+	for(iter=0;iter<block->rows.size();iter++){
+		int row=block->rows[iter];
+		double rhs=job->rowRHS[row];
+		char sense=job->rowSense[row];
+		if((sense=='L' && rhs<0) || (sense=='G' && rhs>0) || (sense=='E' && rhs!=0) ||
+			(sense=='R' && (rhs<0 || rhs-job->rowRange[row]>0))){
+			block->status=TM_NO_SOLUTION;
+			block->hasSolution=false;
+			return;
+		}
+	}
+	for(iter=0;iter<block->cols.size();iter++){
+		int col=block->cols[iter];
+		double lower=job->lower[col],upper=job->upper[col],cost=job->objSense*job->objective[col],x;
+		if(job->isInt[col]){
+			lower=ceil(lower);
+			upper=floor(upper);
+		}
+		if(lower>upper){
+			block->status=TM_NO_SOLUTION;
+			block->hasSolution=false;
+			return;
+		}
+		if(cost>0)
+			x=lower;
+		else if(cost<0)
+			x=upper;
+		else
+			x=lower>-infinity?lower:(upper<infinity?upper:0);
+		if(x<=-infinity || x>=infinity){
+			block->status=TM_UNBOUNDED;
+			block->hasSolution=false;
+			return;
+		}
+		block->solution[iter]=x;
+		block->objVal+=job->objective[col]*x;
+	}
+}
+
+static void *blocksThread(void *arg)
+{
+	blocksJob *job=(blocksJob*)arg;
+	size_t current;
+	while(true){
+		pthread_mutex_lock(&job->lock);
+		current=job->next++;
+		pthread_mutex_unlock(&job->lock);
+		if(current>=job->blocks.size())
+			break;
+		//once the group is stopping, the blocks left are not solved
+		if(solve_group_stopping()){
+			job->blocks[current].status=TM_SIGNAL_CAUGHT;
+			job->blocks[current].hasSolution=false;
+			continue;
+		}
+		solveBlock(job,&job->blocks[current]);
+	}
+	return NULL;
+}
+
+//get the problem of env into job, returns false if there is none
+static bool getBlocksProblem(sym_environment *env, blocksJob *job)
+{
+	int numElements,iter;
+	char isInt;
+	if(sym_get_num_cols(env,&job->numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(env,&job->numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_sense(env,&job->objSense)==FUNCTION_TERMINATED_ABNORMALLY)
+		return false;
+	job->colStart.resize(job->numCols+1);
+	job->rowIndex.resize(numElements+1);
+	job->value.resize(numElements+1);
+	job->lower.resize(job->numCols+1);
+	job->upper.resize(job->numCols+1);
+	job->objective.resize(job->numCols+1);
+	job->isInt.resize(job->numCols+1);
+	job->rowSense.resize(job->numRows+1);
+	job->rowRHS.resize(job->numRows+1);
+	job->rowRange.resize(job->numRows+1);
+	if(sym_get_matrix(env,&numElements,&job->colStart[0],&job->rowIndex[0],&job->value[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_lower(env,&job->lower[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_upper(env,&job->upper[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_coeff(env,&job->objective[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		(job->numRows && sym_get_row_sense(env,&job->rowSense[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(job->numRows && sym_get_rhs(env,&job->rowRHS[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(job->numRows && sym_get_row_range(env,&job->rowRange[0])==FUNCTION_TERMINATED_ABNORMALLY))
+		return false;
+	//symphony gives the objective of a maximization negated; the blocks take it as it was given and set the sense
+	for(iter=0;iter<job->numCols;iter++){
+		sym_is_integer(env,iter,&isInt);
+		job->isInt[iter]=isInt?TRUE:FALSE;
+		job->objective[iter]*=job->objSense;
+	}
+	return true;
+}
+
+extern "C" {
+
+int sci_sym_getBlocks(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	blocksJob job;
+	std::vector<int> colBlock,rowBlock;
+	double *values;
+	int numBlocks,iter;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,3) ;
+
+	if(!getBlocksProblem(global_sym_env,&job)){
+		Scierror(999, "No problem is loaded. Please load a problem first.\n");
+		return 1;
+	}
+	numBlocks=blocksFind(job.numCols,job.numRows,&job.colStart[0],&job.rowIndex[0],colBlock,rowBlock);
+
+	//code to give output: the number of blocks, and the block of each variable and constraint, from 1
+	if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numBlocks))
+		return 1;
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,1,job.numCols,&values);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=0;iter<job.numCols;iter++)
+		values[iter]=colBlock[iter]+1;
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+3,job.numRows,1,&values);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=0;iter<job.numRows;iter++)
+		values[iter]=rowBlock[iter]+1;
+	for(iter=1;iter<=3;iter++)
+		AssignOutputVariable(pvApiCtx,iter)=nbInputArgument(pvApiCtx)+iter;
+
+	return 0;
+}
+
+int sci_sym_solveBlocks(char *fname){
+
+	//data declarations
+	blocksJob job;
+	std::vector<int> colBlock,rowBlock;
+	std::vector<double> solution;
+	std::vector<pthread_t> threads;
+	double numThreadsInput,startTime=wallClock(),objVal=0;
+	int numBlocks,numThreads,status=TM_OPTIMAL_SOLUTION_FOUND,iter,iRet;
+	size_t index;
+	bool merged=true;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: number of threads, by default one for each processor
+	numThreads=sysconf(_SC_NPROCESSORS_ONLN);
+	if(nbInputArgument(pvApiCtx)==1){
+		if(getDoubleFromScilab(1,&numThreadsInput))
+			return 1;
+		if(numThreadsInput<1 || numThreadsInput!=(int)numThreadsInput){
+			Scierror(999, "Wrong value for input argument #1: A positive integer is expected.\n");
+			return 1;
+		}
+		numThreads=(int)numThreadsInput;
+	}
+	if(numThreads<1)
+		numThreads=1;
+
+	if(!getBlocksProblem(global_sym_env,&job)){
+		Scierror(999, "No problem is loaded. Please load a problem first.\n");
+		return 1;
+	}
+	numBlocks=blocksFind(job.numCols,job.numRows,&job.colStart[0],&job.rowIndex[0],colBlock,rowBlock);
+	if(numBlocks<=1){
+		Scierror(999, "The problem has only one block. Please use 'sym_solve()' instead.\n");
+		return 1;
+	}
+
+	//split the problem; the free block, if any, is the last one and is solved here
+	job.blocks.resize(numBlocks);
+	job.rowLocal.resize(job.numRows);
+	for(iter=0;iter<job.numCols;iter++)
+		job.blocks[colBlock[iter]].cols.push_back(iter);
+	for(iter=0;iter<job.numRows;iter++){
+		job.rowLocal[iter]=job.blocks[rowBlock[iter]].rows.size();
+		job.blocks[rowBlock[iter]].rows.push_back(iter);
+	}
+	//every other block has a column with a nonzero
+	blockWork freeBlock=job.blocks.back();
+	bool hasFreeBlock=freeBlock.cols.empty() || job.colStart[freeBlock.cols[0]]==job.colStart[freeBlock.cols[0]+1];
+	if(hasFreeBlock)
+		job.blocks.pop_back();
+
+	//the parameters of the main environment apply to each block
+	for(iter=0;blockIntParams[iter];iter++){
+		int intValue=0;
+		job.hasIntParam.push_back(sym_get_int_param(global_sym_env,blockIntParams[iter],&intValue)!=FUNCTION_TERMINATED_ABNORMALLY);
+		job.intParams.push_back(intValue);
+	}
+	for(iter=0;blockDblParams[iter];iter++){
+		double dblValue=0;
+		job.hasDblParam.push_back(sym_get_dbl_param(global_sym_env,blockDblParams[iter],&dblValue)!=FUNCTION_TERMINATED_ABNORMALLY);
+		job.dblParams.push_back(dblValue);
+	}
+
+	//solve the blocks, each thread taking the next block that is left
+	if((size_t)numThreads>job.blocks.size())
+		numThreads=job.blocks.size();
+	job.next=0;
+	pthread_mutex_init(&job.lock,NULL);
+	solve_group_begin(-1,NULL);
+	threads.resize(numThreads);
+	for(iter=0;iter<numThreads;iter++)
+		if(pthread_create(&threads[iter],NULL,blocksThread,&job)){
+			numThreads=iter;
+			break;
+		}
+	if(numThreads==0)
+		blocksThread(&job);
+	for(iter=0;iter<numThreads;iter++)
+		pthread_join(threads[iter],NULL);
+	solve_group_end();
+	pthread_mutex_destroy(&job.lock);
+	if(hasFreeBlock){
+		solveFreeBlock(&job,&freeBlock);
+		job.blocks.push_back(freeBlock);
+	}
+
+	//merge the solutions; the problem has no solution if one block has none
+	solution.assign(job.numCols+1,0.0);
+	for(index=0;index<job.blocks.size();index++){
+		blockWork &block=job.blocks[index];
+		if(!block.hasSolution){
+			if(merged)
+				status=block.status;
+			merged=false;
+			continue;
+		}
+		for(iter=0;iter<(int)block.cols.size();iter++)
+			solution[block.cols[iter]]=block.solution[iter];
+		objVal+=block.objVal;
+		if(merged && status==TM_OPTIMAL_SOLUTION_FOUND && block.status!=TM_OPTIMAL_SOLUTION_FOUND && block.status!=PREP_OPTIMAL_SOLUTION_FOUND)
+			status=block.status;
+	}
+	sciprint("Solved %d blocks on %d threads in %.3f s.\n",numBlocks,numThreads>0?numThreads:1,wallClock()-startTime);
+
+	//the merged solution becomes the solution of the main environment, for the solution functions
+	if(merged){
+		iRet=sym_set_col_solution(global_sym_env,&solution[0]);
+		if(iRet==FUNCTION_TERMINATED_ABNORMALLY)
+			sciprint("Warning: Symphony did not take the merged solution.\n");
+		else
+			sym_set_primal_bound(global_sym_env,objVal);
+		sciprint("Objective value of the merged solution: %g\n",objVal);
+	}
+
+	//code to give output
+	return returnDoubleToScilab(process_ret_val(status));
+}
+
+}
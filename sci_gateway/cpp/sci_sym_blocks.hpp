@@ -0,0 +1,17 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for finding the independent blocks of a problem
+// Two columns are in the same block when a row links them, directly or through other columns
+
+#ifndef SCI_SYMBLOCKSHEADER
+#define SCI_SYMBLOCKSHEADER
+
+#include <vector>
+
+//find the connected components of the row-column graph of the matrix given in column-major form
+//colBlock and rowBlock get the block of each column and row, numbered in the order of their first column;
+//the columns and rows that are in no row or have no column are put together in a last block
+//returns the number of blocks
+int blocksFind(int numCols, int numRows, const int *colStart, const int *rowIndex,
+	std::vector<int> &colBlock, std::vector<int> &rowBlock);
+
+#endif //SCI_SYMBLOCKSHEADER
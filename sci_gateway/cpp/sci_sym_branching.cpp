@@ -0,0 +1,296 @@
+/*
+ * Symphony Toolbox
+ * Branching priorities of the variables and special ordered sets
+ * Symphony chooses its branching variables itself, so the priorities order the fixings of the dive of the heuristics;
+ * a special ordered set is added to the problem as binary variables and constraints that have the same solutions
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_branching.hpp"
+#include "sci_sym_heuristics.hpp"
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+}
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+static std::map<sym_environment*,std::vector<double> > branchingStates;
+
+const std::vector<double> *branchingPriorities(sym_environment *env)
+{
+	std::map<sym_environment*,std::vector<double> >::iterator found=branchingStates.find(env);
+	if(found==branchingStates.end())
+		return NULL;
+	return &found->second;
+}
+
+void branchingForget(sym_environment *env)
+{
+	branchingStates.erase(env);
+}
+
+//a member of a special ordered set, ordered by its weight
+struct sosMember{
+	double weight;
+	int col;
+};
+
+static bool lighterMember(const sosMember &first, const sosMember &second)
+{
+	return first.weight<second.weight;
+}
+
+//add lower*z <= x <= upper*z, with z the sum of the binaries in zCols; the lower part is left out if it is 0
+static int addLinkRows(sym_environment *env, int col, double lower, double upper, const std::vector<int> &zCols)
+{
+	std::vector<int> indices(1,col);
+	std::vector<double> elements(1,1.0);
+	size_t iter;
+	int iRet;
+	indices.insert(indices.end(),zCols.begin(),zCols.end());
+	for(iter=0;iter<zCols.size();iter++)
+		elements.push_back(-upper);
+	iRet=sym_add_row(env,indices.size(),&indices[0],&elements[0],'L',0,0);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY || lower==0)
+		return iRet;
+	for(iter=0;iter<zCols.size();iter++)
+		elements[iter+1]=-lower;
+	return sym_add_row(env,indices.size(),&indices[0],&elements[0],'G',0,0);
+}
+
+//delete the rows and columns added to env after it had numRows rows and numCols columns
+static void removeAdded(sym_environment *env, int numRows, int numCols)
+{
+	std::vector<int> added;
+	int count,iter;
+	if(sym_get_num_rows(env,&count)!=FUNCTION_TERMINATED_ABNORMALLY && count>numRows){
+		for(iter=numRows;iter<count;iter++)
+			added.push_back(iter);
+		sym_delete_rows(env,added.size(),&added[0]);
+	}
+	added.clear();
+	if(sym_get_num_cols(env,&count)!=FUNCTION_TERMINATED_ABNORMALLY && count>numCols){
+		for(iter=numCols;iter<count;iter++)
+			added.push_back(iter);
+		sym_delete_cols(env,added.size(),&added[0]);
+	}
+}
+
+extern "C" {
+
+int sci_sym_setPriorities(char *fname){
+
+	//data declarations
+	int numVars;
+	double *priorities;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: priority of each variable, the highest are fixed first
+	if(getFixedSizeDoubleMatrixFromScilab(1,1,numVars,&priorities))
+		return 1;
+	branchingStates[global_sym_env].assign(priorities,priorities+numVars);
+	if(!heuristicsEnabled())
+		sciprint("Warning: the priorities are only used by the heuristics, enable them with sym_setHeuristics(1).\n");
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_getPriorities(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int numVars,iter;
+	double *values;
+	const std::vector<double> *priorities;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//code to give output: 0 for the variables that have no priority
+	priorities=branchingPriorities(global_sym_env);
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,numVars,&values);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=0;iter<numVars;iter++)
+		values[iter]=(priorities && (size_t)iter<priorities->size())?(*priorities)[iter]:0;
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	return 0;
+}
+
+int sci_sym_addSOS(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int numVars,numConstr,rows,cols,numMembers,iter,iRet=FUNCTION_TERMINATED_NORMALLY;
+	double type,*indices,*weights=NULL,infinity=sym_get_infinity(),*values;
+	std::vector<sosMember> members;
+	std::vector<int> binaries,zCols;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,2,3) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(global_sym_env,&numConstr)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: type of the set, 1 or 2
+	if(getDoubleFromScilab(1,&type))
+		return 1;
+	if(type!=1 && type!=2){
+		Scierror(999, "Wrong value for input argument #1: 1 or 2 is expected.\n");
+		return 1;
+	}
+
+	//get input 2: indices of the variables of the set
+	if(getDoubleMatrixFromScilab(2,&rows,&cols,&indices))
+		return 1;
+	numMembers=rows*cols;
+	if(numMembers<2 || (rows!=1 && cols!=1)){
+		Scierror(999, "Wrong size for input argument #2: A vector of at least 2 indices is expected.\n");
+		return 1;
+	}
+
+	//get input 3: weights giving the order of the variables, their order in input 2 by default
+	if(nbInputArgument(pvApiCtx)==3 && getFixedSizeDoubleMatrixFromScilab(3,rows,cols,&weights))
+		return 1;
+
+	std::vector<double> lower(numVars),upper(numVars);
+	sym_get_col_lower(global_sym_env,&lower[0]);
+	sym_get_col_upper(global_sym_env,&upper[0]);
+	std::vector<char> inSet(numVars,0);
+	for(iter=0;iter<numMembers;iter++){
+		sosMember member;
+		if(indices[iter]<0 || indices[iter]>=numVars || indices[iter]!=(int)indices[iter]){
+			Scierror(999, "Wrong value for input argument #2: Entry %d must be a whole number between 0 and %d.\n",iter+1,numVars-1);
+			return 1;
+		}
+		member.col=(int)indices[iter];
+		member.weight=weights?weights[iter]:iter;
+		if(inSet[member.col]){
+			Scierror(999, "Wrong value for input argument #2: Variable %d appears twice.\n",member.col);
+			return 1;
+		}
+		inSet[member.col]=1;
+		//the binaries switch the variable between 0 and its bounds, which must be finite and around 0
+		if(lower[member.col]<=-infinity || upper[member.col]>=infinity || lower[member.col]>0 || upper[member.col]<0){
+			Scierror(999, "Variable %d of the set must have finite bounds with 0 between them.\n",member.col);
+			return 1;
+		}
+		members.push_back(member);
+	}
+	std::stable_sort(members.begin(),members.end(),lighterMember);
+	for(iter=1;iter<numMembers;iter++)
+		if(members[iter].weight==members[iter-1].weight){
+			Scierror(999, "Wrong value for input argument #3: The weights must be different.\n");
+			return 1;
+		}
+
+	//SOS1: one binary for each variable, at most one of them is 1
+	//SOS2: one binary for each pair of neighbours, a variable can only be nonzero if the binary of one of its pairs is 1
+	int numBinaries=(type==1)?numMembers:numMembers-1;
+	for(iter=0;iter<numBinaries && iRet!=FUNCTION_TERMINATED_ABNORMALLY;iter++){
+		iRet=sym_add_col(global_sym_env,0,NULL,NULL,0,1,0,TRUE,NULL);
+		binaries.push_back(numVars+iter);
+	}
+	for(iter=0;iter<numMembers && iRet!=FUNCTION_TERMINATED_ABNORMALLY;iter++){
+		zCols.clear();
+		if(type==1)
+			zCols.push_back(binaries[iter]);
+		else{
+			if(iter>0)
+				zCols.push_back(binaries[iter-1]);
+			if(iter<numMembers-1)
+				zCols.push_back(binaries[iter]);
+		}
+		iRet=addLinkRows(global_sym_env,members[iter].col,lower[members[iter].col],upper[members[iter].col],zCols);
+	}
+	if(iRet!=FUNCTION_TERMINATED_ABNORMALLY){
+		std::vector<double> ones(numBinaries,1.0);
+		iRet=sym_add_row(global_sym_env,numBinaries,&binaries[0],&ones[0],'L',1,0);
+	}
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		//the problem is left as it was, without the part of the set already added
+		removeAdded(global_sym_env,numConstr,numVars);
+		Scierror(999, "An error occured while adding the set to the problem.\n");
+		return 1;
+	}
+	sciprint("Special ordered set of type %d added with %d binary variables, from index %d.\n",(int)type,numBinaries,numVars);
+
+	//code to give output: the indices of the binaries
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,numBinaries,&values);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=0;iter<numBinaries;iter++)
+		values[iter]=binaries[iter];
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	return 0;
+}
+
+}
@@ -0,0 +1,19 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for branching priorities and special ordered sets
+// The priorities are kept for each environment; the special ordered sets are added to the problem
+// as binary variables and constraints
+
+#ifndef SCI_SYMBRANCHINGHEADER
+#define SCI_SYMBRANCHINGHEADER
+
+#include "symphony.h"
+
+#include <vector>
+
+//the priorities set for the problem in env, one for each column, NULL if none are set
+const std::vector<double> *branchingPriorities(sym_environment *env);
+
+//forget the priorities of env, to be called when env is closed
+void branchingForget(sym_environment *env);
+
+#endif //SCI_SYMBRANCHINGHEADER
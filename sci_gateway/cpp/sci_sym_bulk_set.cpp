@@ -0,0 +1,186 @@
+/*
+ * Symphony Toolbox
+ * Functions for changing bounds, objective coefficients and variable types
+ * of many variables or constraints in a single call
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <string.h>
+
+//get input argNum as a vector of indices, each a whole number between 0 and maxIndex-1
+static int getIndexVectorFromScilab(int argNum, int maxIndex, int *count, double **indices)
+{
+	int rows,cols,iter;
+	if(getDoubleMatrixFromScilab(argNum,&rows,&cols,indices))
+		return 1;
+	if(rows!=1 && cols!=1 && rows*cols!=0){
+		Scierror(999, "Wrong size for input argument #%d: A vector of indices is expected.\n",argNum);
+		return 1;
+	}
+	*count=rows*cols;
+	for(iter=0;iter<*count;iter++)
+		if((*indices)[iter]<0 || (*indices)[iter]>=maxIndex || (*indices)[iter]!=(int)(*indices)[iter]){
+			Scierror(999, "Wrong value for input argument #%d: Entry %d must be a whole number between 0 and %d.\n",argNum,iter+1,maxIndex-1);
+			return 1;
+		}
+	return 0;
+}
+
+//get input argNum as a vector of values, either a scalar or one value per index
+static int getValueVectorFromScilab(int argNum, int count, double **values, int *step)
+{
+	int rows,cols;
+	if(getDoubleMatrixFromScilab(argNum,&rows,&cols,values))
+		return 1;
+	if(rows*cols==1)
+		*step=0; //the same value is used for every index
+	else if((rows==1 || cols==1) && rows*cols==count)
+		*step=1;
+	else{
+		Scierror(999, "Wrong size for input argument #%d: A scalar or a vector of %d values is expected.\n",argNum,count);
+		return 1;
+	}
+	return 0;
+}
+
+static int getProblemSize(bool ofConstraints, int *size)
+{
+	int iRet;
+	if(ofConstraints)
+		iRet=sym_get_num_rows(global_sym_env,size);
+	else
+		iRet=sym_get_num_cols(global_sym_env,size);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+	return 0;
+}
+
+//sym_setVarLowers, sym_setVarUppers, sym_setConstrLowers, sym_setConstrUppers and sym_setObjCoeffs
+int sci_sym_setBulkValues(char *fname){
+
+	//error management variable
+	int iRet=0;
+
+	//data declarations
+	int count,size,step,iter;
+	double *indices=NULL,*values=NULL;
+	bool ofConstraints;
+	int (*setter)(sym_environment*,int,double);
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,2,2) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//decide which function to execute
+	ofConstraints=(strncmp(fname,"sym_setConstr",13)==0);
+	if(strcmp(fname,"sym_setVarLowers")==0)
+		setter=sym_set_col_lower;
+	else if(strcmp(fname,"sym_setVarUppers")==0)
+		setter=sym_set_col_upper;
+	else if(strcmp(fname,"sym_setConstrLowers")==0)
+		setter=sym_set_row_lower;
+	else if(strcmp(fname,"sym_setConstrUppers")==0)
+		setter=sym_set_row_upper;
+	else
+		setter=sym_set_obj_coeff;
+
+	if(getProblemSize(ofConstraints,&size))
+		return 1;
+
+	//get argument 1: indices of the variables or constraints to be changed
+	if(getIndexVectorFromScilab(1,size,&count,&indices))
+		return 1;
+
+	//get argument 2: new values
+	if(getValueVectorFromScilab(2,count,&values,&step))
+		return 1;
+
+	//all input has been checked, so apply the changes without any further checks
+	for(iter=0;iter<count && iRet!=FUNCTION_TERMINATED_ABNORMALLY;iter++)
+		iRet=setter(global_sym_env,(int)indices[iter],values[iter*step]);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}else{
+		sciprint("%d values successfully changed.\n",count);
+	}
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+//sym_setIntegers and sym_setContinuousVars
+int sci_sym_setBulkVarType(char *fname){
+
+	//error management variable
+	int iRet=0;
+
+	//data declarations
+	int count,numVars,iter;
+	double *indices=NULL;
+	bool isInteger;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(getProblemSize(false,&numVars))
+		return 1;
+
+	//get argument 1: indices of the variables to be changed
+	if(getIndexVectorFromScilab(1,numVars,&count,&indices))
+		return 1;
+
+	isInteger=(strcmp(fname,"sym_setIntegers")==0);
+	for(iter=0;iter<count && iRet!=FUNCTION_TERMINATED_ABNORMALLY;iter++){
+		if(isInteger)
+			iRet=sym_set_integer(global_sym_env,(int)indices[iter]);
+		else
+			iRet=sym_set_continuous(global_sym_env,(int)indices[iter]);
+	}
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}else{
+		sciprint("%d variables successfully changed.\n",count);
+	}
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+}
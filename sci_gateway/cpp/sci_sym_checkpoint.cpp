@@ -0,0 +1,340 @@
+/*
+ * Symphony Toolbox
+ * Checkpoints of long solves and resuming from them
+ * A checkpoint is the warm start of the solve, which holds its tree and cuts, written to a file, and its
+ * incumbent written next to it with the extension .sol; both are replaced only once completely written
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_progress.hpp"
+#include "sci_sym_checkpoint.hpp"
+#include <pthread.h>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+#include <math.h>
+int process_ret_val(int);
+int interruptible_solve(sym_environment*,int);
+int sliced_solve(sym_environment*,int,double,int*);
+}
+
+#define CHECKPOINT_SOLUTION_MAGIC "SYMCHECKPOINT"
+
+//where and how often checkpoints are written, set by sym_setCheckpoint
+static std::string checkpointFile;
+static double checkpointSeconds=0;
+static int checkpointNodes=0;
+
+//nodes analyzed before the solve started, as far as known: symphony counts the nodes of a tree from its start
+static int checkpointNodeBase=0;
+
+//a checkpoint being written on its own thread
+struct checkpointData{
+	warm_start_desc *ws;	//a copy, deleted once written
+	std::string file;
+	std::vector<double> solution;	//empty if there is no incumbent
+	double objValue;
+	int nodes;
+	bool failed;
+	volatile bool done;
+};
+
+static checkpointData *pendingCheckpoint=NULL;
+static pthread_t checkpointWriter;
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+//write the incumbent, and the nodes analyzed so far as far as known, to file
+static bool writeSolutionFile(const checkpointData *data, const char *file)
+{
+	FILE *out=fopen(file,"w");
+	size_t iter;
+	bool written;
+	if(out==NULL)
+		return false;
+	written=fprintf(out,"%s\nnodes %d\nobjective %.17g\ncolumns %d\n",CHECKPOINT_SOLUTION_MAGIC,data->nodes,
+		data->solution.empty()?NAN:data->objValue,(int)data->solution.size())>0;
+	for(iter=0;iter<data->solution.size() && written;iter++)
+		written=fprintf(out,"%.17g\n",data->solution[iter])>0;
+	return (fclose(out)==0) && written;
+}
+
+static void *checkpointThread(void *arg)
+{
+	checkpointData *data=(checkpointData*)arg;
+	std::string tempFile=data->file+".tmp",solutionFile=data->file+".sol",tempSolution=solutionFile+".tmp";
+	//each file is written under a temporary name first, so that a crash leaves the previous checkpoint whole
+	data->failed=sym_write_warm_start_desc(data->ws,(char*)tempFile.c_str())==FUNCTION_TERMINATED_ABNORMALLY ||
+		!writeSolutionFile(data,tempSolution.c_str()) ||
+		rename(tempFile.c_str(),data->file.c_str()) || rename(tempSolution.c_str(),solutionFile.c_str());
+	sym_delete_warm_start(data->ws);
+	data->ws=NULL;
+	data->done=true;
+	return NULL;
+}
+
+//wait for the checkpoint being written, if any
+static void checkpointJoin()
+{
+	if(pendingCheckpoint==NULL)
+		return;
+	pthread_join(checkpointWriter,NULL);
+	if(pendingCheckpoint->failed)
+		sciprint("Warning: Unable to write the checkpoint file %s.\n",pendingCheckpoint->file.c_str());
+	delete pendingCheckpoint;
+	pendingCheckpoint=NULL;
+}
+
+//start writing a checkpoint of env, unless the previous one is still being written and wait is false
+static void checkpointWrite(sym_environment *env, int nodes, bool wait)
+{
+	checkpointData *data;
+	int numVars;
+	if(pendingCheckpoint!=NULL && !pendingCheckpoint->done && !wait)
+		return;
+	checkpointJoin();
+	data=new checkpointData;
+	//the copy lets the solve go on while it is written
+	data->ws=sym_get_warm_start(env,TRUE);
+	if(data->ws==NULL){
+		delete data;
+		return;
+	}
+	data->file=checkpointFile;
+	data->nodes=nodes;
+	data->failed=false;
+	data->done=false;
+	if(sym_get_num_cols(env,&numVars)!=FUNCTION_TERMINATED_ABNORMALLY && numVars>0){
+		data->solution.resize(numVars);
+		if(sym_get_col_solution(env,&data->solution[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+			sym_get_obj_val(env,&data->objValue)==FUNCTION_TERMINATED_ABNORMALLY)
+			data->solution.clear();
+	}
+	if(pthread_create(&checkpointWriter,NULL,checkpointThread,data)){
+		checkpointThread(data);
+		if(data->failed)
+			sciprint("Warning: Unable to write the checkpoint file %s.\n",data->file.c_str());
+		delete data;
+		return;
+	}
+	pendingCheckpoint=data;
+}
+
+int checkpointEnabled()
+{
+	return !checkpointFile.empty();
+}
+
+int checkpointSolve(sym_environment *env, int warm)
+{
+	int status,paused,keepWarmStart=FALSE,userNodeLimit=-1,nodeLimit,nodesDone=checkpointNodeBase,analyzed;
+	double userTimeLimit=-1,slice,startTime=wallClock();
+	bool stoppedForCheckpoint;
+
+	//the time limit is kept by the slices, so that it covers the whole solve and not each part of it
+	sym_get_int_param(env,"keep_warm_start",&keepWarmStart);
+	sym_get_int_param(env,"node_limit",&userNodeLimit);
+	sym_get_dbl_param(env,"time_limit",&userTimeLimit);
+	sym_set_int_param(env,"keep_warm_start",TRUE);
+	sym_set_dbl_param(env,"time_limit",-1);
+	do{
+		nodeLimit=userNodeLimit;
+		if(checkpointNodes>0 && (userNodeLimit<0 || nodesDone+checkpointNodes<userNodeLimit))
+			nodeLimit=nodesDone+checkpointNodes;
+		sym_set_int_param(env,"node_limit",nodeLimit);
+		slice=(checkpointSeconds>0)?checkpointSeconds:-1;
+		if(userTimeLimit>=0 && (slice<0 || userTimeLimit-(wallClock()-startTime)<slice))
+			slice=(userTimeLimit>wallClock()-startTime)?userTimeLimit-(wallClock()-startTime):0;
+		status=sliced_solve(env,warm,slice,&paused);
+		warm=1;
+		if(paused && userTimeLimit>=0 && wallClock()-startTime>=userTimeLimit)
+			status=TM_TIME_LIMIT_EXCEEDED;
+		stoppedForCheckpoint=(paused && status==TM_SIGNAL_CAUGHT) || (status==TM_NODE_LIMIT_EXCEEDED && nodeLimit!=userNodeLimit);
+		//each slice ends with its own count of the nodes of the tree, whatever stopped it
+		if(sym_get_iteration_count(env,&analyzed)!=FUNCTION_TERMINATED_ABNORMALLY && analyzed>=nodesDone)
+			nodesDone=analyzed;
+		else if(status==TM_NODE_LIMIT_EXCEEDED)
+			nodesDone=nodeLimit;
+		//a solve that is stopped before the end is checkpointed too, so that it can be resumed
+		if(stoppedForCheckpoint || status==TM_SIGNAL_CAUGHT || status==TM_TIME_LIMIT_EXCEEDED || status==TM_NODE_LIMIT_EXCEEDED)
+			checkpointWrite(env,nodesDone,!stoppedForCheckpoint);
+	}while(stoppedForCheckpoint);
+	checkpointJoin();
+	sym_set_int_param(env,"keep_warm_start",keepWarmStart);
+	sym_set_int_param(env,"node_limit",userNodeLimit);
+	sym_set_dbl_param(env,"time_limit",userTimeLimit);
+	checkpointNodeBase=0;
+	return status;
+}
+
+//read the incumbent and the nodes analyzed of the checkpoint file, returns 0 if it cannot be read
+static int readSolutionFile(const char *file, int numVars, std::vector<double> &solution, int *nodes)
+{
+	FILE *in=fopen(file,"r");
+	char magic[32];
+	double objValue;
+	int columns,iter;
+	bool read;
+	if(in==NULL)
+		return 0;
+	read=fscanf(in,"%31s nodes %d objective %lf columns %d",magic,nodes,&objValue,&columns)==4 &&
+		std::string(magic)==CHECKPOINT_SOLUTION_MAGIC && (columns==0 || columns==numVars);
+	solution.resize(read?columns:0);
+	for(iter=0;iter<(int)solution.size() && read;iter++)
+		read=fscanf(in,"%lf",&solution[iter])==1;
+	fclose(in);
+	if(!read)
+		solution.clear();
+	return read;
+}
+
+extern "C" {
+
+int sci_sym_setCheckpoint(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress;
+	char *fileName=NULL;
+	double seconds,nodes=0;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,3) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//no input: checkpoints are no longer written
+	if(nbInputArgument(pvApiCtx)==0){
+		checkpointFile.clear();
+		return return0toScilab();
+	}
+	if(nbInputArgument(pvApiCtx)==1){
+		Scierror(999, "Wrong number of input arguments: 0, 2 or 3 expected.\n");
+		return 1;
+	}
+
+	//get input 1: name of the checkpoint file
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A file name is expected.\n");
+		return 1;
+	}
+
+	//get input 2: seconds between checkpoints, 0 for none based on time
+	//get input 3: nodes between checkpoints, 0 for none based on nodes
+	if(getDoubleFromScilab(2,&seconds) || (nbInputArgument(pvApiCtx)==3 && getDoubleFromScilab(3,&nodes))){
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	if(seconds<0 || nodes<0 || nodes!=(int)nodes || (seconds==0 && nodes==0) || fileName[0]=='\0'){
+		freeAllocatedSingleString(fileName);
+		Scierror(999, "Wrong value for input arguments: A file name and a positive number of seconds or nodes are expected.\n");
+		return 1;
+	}
+	checkpointFile=fileName;
+	checkpointSeconds=seconds;
+	checkpointNodes=(int)nodes;
+	freeAllocatedSingleString(fileName);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_resume(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress,numVars,nodes=0,status,capturing;
+	char *fileName=NULL;
+	warm_start_desc *ws;
+	std::vector<double> solution;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: name of the checkpoint file
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A file name is expected.\n");
+		return 1;
+	}
+
+	//the tree, and the incumbent if there is one
+	ws=sym_read_warm_start(fileName);
+	if(ws==NULL){
+		Scierror(999, "An error occured while reading the checkpoint file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	status=sym_set_warm_start(global_sym_env,ws);
+	sym_delete_warm_start(ws);
+	if(status==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "The checkpoint does not fit the loaded problem.\n");
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	if(readSolutionFile((std::string(fileName)+".sol").c_str(),numVars,solution,&nodes) && !solution.empty())
+		sym_set_col_solution(global_sym_env,&solution[0]);
+	freeAllocatedSingleString(fileName);
+
+	//continue the tree, writing checkpoints again if they are asked for
+	capturing=progressBegin(global_sym_env);
+	if(checkpointEnabled()){
+		checkpointNodeBase=nodes;
+		status=checkpointSolve(global_sym_env,1);
+	}else
+		status=interruptible_solve(global_sym_env,1);
+	if(capturing)
+		progressEnd();
+	status=process_ret_val(status);
+
+	//code to give output
+	return returnDoubleToScilab(status);
+}
+
+}
@@ -0,0 +1,18 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for writing checkpoints of a running solve
+// The solve is stopped every so many seconds or nodes, its tree and incumbent are written to a file
+// on another thread, and it is continued with a warm solve
+
+#ifndef SCI_SYMCHECKPOINTHEADER
+#define SCI_SYMCHECKPOINTHEADER
+
+#include "symphony.h"
+
+//whether sym_solve writes checkpoints
+int checkpointEnabled();
+
+//solve the problem in env like interruptible_solve, from its warm start if warm is nonzero,
+//writing a checkpoint each time the solve is stopped, returns the return value of symphony
+int checkpointSolve(sym_environment *env, int warm);
+
+#endif //SCI_SYMCHECKPOINTHEADER
@@ -0,0 +1,278 @@
+/*
+ * Symphony Toolbox
+ * Functions for choosing when each Cgl cut generator is used, and for reporting what each one did in the last solve
+ * The bound improvement of the root is measured against the LP relaxation, for all the cuts together
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_progress.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "CoinError.hpp"
+#include <vector>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+
+//parameter names of the generators, in the order of cutGeneratorFields
+static const char *cutParamNames[NUM_CUT_GENERATORS]={"gomory","knapsack","oddhole","clique","probing","mir",
+	"twomir","flowcover","rounding","lift_and_project","landp","redsplit"};
+
+//modes of a generator, the value of a mode is its position minus one (DO_NOT_GENERATE .. GENERATE_PERIODICALLY)
+#define NUM_CUT_MODES 6
+static const char *cutModeNames[NUM_CUT_MODES]={"off","default","ifRoot","rootOnly","always","periodic"};
+
+//columns of the table given by sym_getCutStats
+#define NUM_CUT_STATS 4
+
+//get a string from input pos, to be freed with freeAllocatedSingleString
+static int getStringArgument(int pos, char **text)
+{
+	SciErr sciErr;
+	int *varAddress;
+	sciErr = getVarAddressFromPosition(pvApiCtx, pos, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, text) )
+	{
+		Scierror(999, "Wrong type for input argument #%d: A string is expected.\n",pos);
+		return 1;
+	}
+	return 0;
+}
+
+//objective value of the LP relaxation of the problem in env, as symphony minimizes it; NaN if it cannot be solved
+static double lpRelaxationBound(sym_environment *env)
+{
+	int numCols,numRows,numElements;
+	if(sym_get_num_cols(env,&numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(env,&numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY)
+		return NAN;
+	std::vector<int> colStart(numCols+1),rowIndex(numElements+1);
+	std::vector<double> value(numElements+1),lower(numCols+1),upper(numCols+1),objective(numCols+1);
+	std::vector<double> rowLower(numRows+1),rowUpper(numRows+1);
+	if(sym_get_matrix(env,&numElements,&colStart[0],&rowIndex[0],&value[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_lower(env,&lower[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_upper(env,&upper[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_coeff(env,&objective[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		(numRows && sym_get_row_lower(env,&rowLower[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(numRows && sym_get_row_upper(env,&rowUpper[0])==FUNCTION_TERMINATED_ABNORMALLY))
+		return NAN;
+	try{
+		OsiClpSolverInterface lp;
+		lp.messageHandler()->setLogLevel(0);
+		lp.loadProblem(numCols,numRows,&colStart[0],&rowIndex[0],&value[0],&lower[0],&upper[0],&objective[0],&rowLower[0],&rowUpper[0]);
+		//symphony gives the objective of a maximization negated, so the LP is a minimization like its tree
+		lp.setObjSense(1);
+		lp.initialSolve();
+		if(!lp.isProvenOptimal())
+			return NAN;
+		return lp.getObjValue();
+	}catch(CoinError &error){
+		return NAN;
+	}
+}
+
+int sci_sym_setCuts(char *fname){
+
+	//data declarations
+	char *generator=NULL,*mode=NULL,paramName[64];
+	double frequency;
+	int iter,level=-2,all,found=0;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,2,3) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 2: mode of the generators
+	if(getStringArgument(2,&mode))
+		return 1;
+	for(iter=0;iter<NUM_CUT_MODES;iter++)
+		if(!strcasecmp(mode,cutModeNames[iter]))
+			level=iter-1;
+	freeAllocatedSingleString(mode);
+	if(level==-2){
+		Scierror(999, "Wrong value for input argument #2: 'off', 'default', 'ifRoot', 'rootOnly', 'always' or 'periodic' expected.\n");
+		return 1;
+	}
+
+	//get input 3: number of nodes between two calls of a periodic generator
+	if(nbInputArgument(pvApiCtx)==3){
+		if(getDoubleFromScilab(3,&frequency))
+			return 1;
+		if(frequency<1 || frequency!=floor(frequency)){
+			Scierror(999, "Wrong value for input argument #3: A positive integer is expected.\n");
+			return 1;
+		}
+	}
+
+	//get input 1: name of the generator, or "all"
+	if(getStringArgument(1,&generator))
+		return 1;
+	all=!strcasecmp(generator,"all");
+	for(iter=0;iter<NUM_CUT_GENERATORS;iter++){
+		if(!all && strcasecmp(generator,cutGeneratorFields[iter]))
+			continue;
+		found=1;
+		snprintf(paramName,sizeof(paramName),"generate_cgl_%s_cuts",cutParamNames[iter]);
+		sym_set_int_param(global_sym_env,paramName,level);
+		if(nbInputArgument(pvApiCtx)==3){
+			snprintf(paramName,sizeof(paramName),"generate_cgl_%s_cuts_freq",cutParamNames[iter]);
+			sym_set_int_param(global_sym_env,paramName,(int)frequency);
+		}
+	}
+	if(!found){
+		Scierror(999, "Unknown cut generator %s.\n",generator);
+		freeAllocatedSingleString(generator);
+		return 1;
+	}
+	freeAllocatedSingleString(generator);
+
+	//the generators are only called if cut generation is on; turning all of them off turns it off
+	if(level!=DO_NOT_GENERATE)
+		sym_set_int_param(global_sym_env,"generate_cgl_cuts",TRUE);
+	else if(all)
+		sym_set_int_param(global_sym_env,"generate_cgl_cuts",FALSE);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_getCuts(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	const char *modes[NUM_CUT_GENERATORS];
+	double frequencies[NUM_CUT_GENERATORS];
+	char paramName[64];
+	int iter,level,frequency,enabled=TRUE;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,3) ;
+
+	sym_get_int_param(global_sym_env,"generate_cgl_cuts",&enabled);
+	for(iter=0;iter<NUM_CUT_GENERATORS;iter++){
+		snprintf(paramName,sizeof(paramName),"generate_cgl_%s_cuts",cutParamNames[iter]);
+		if(sym_get_int_param(global_sym_env,paramName,&level)==FUNCTION_TERMINATED_ABNORMALLY)
+			level=GENERATE_DEFAULT;
+		if(!enabled || level<DO_NOT_GENERATE || level>GENERATE_PERIODICALLY)
+			level=DO_NOT_GENERATE;
+		modes[iter]=cutModeNames[level+1];
+		snprintf(paramName,sizeof(paramName),"generate_cgl_%s_cuts_freq",cutParamNames[iter]);
+		if(sym_get_int_param(global_sym_env,paramName,&frequency)==FUNCTION_TERMINATED_ABNORMALLY)
+			frequency=0;
+		frequencies[iter]=frequency;
+	}
+
+	//code to give output
+	sciErr=createMatrixOfString(pvApiCtx,nbInputArgument(pvApiCtx)+1,NUM_CUT_GENERATORS,1,modes);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,NUM_CUT_GENERATORS,1,frequencies);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfString(pvApiCtx,nbInputArgument(pvApiCtx)+3,NUM_CUT_GENERATORS,1,cutGeneratorFields);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=1;iter<=nbOutputArgument(pvApiCtx);iter++)
+		AssignOutputVariable(pvApiCtx,iter)=nbInputArgument(pvApiCtx)+iter;
+
+	return 0;
+}
+
+int sci_sym_getCutStats(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	solveStats stats;
+	double table[NUM_CUT_GENERATORS*NUM_CUT_STATS],lpBound=NAN,rootGain=NAN;
+	int iter;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,3) ;
+
+	if(!progressLastStats(&stats)){
+		Scierror(999, "No statistics are available. Please enable monitoring with 'sym_setProgress()' and run 'sym_solve()' first.\n");
+		return 1;
+	}
+
+	//improvement of the bound by all the cuts of the root, over the bound of the LP relaxation
+	//symphony does not record the share of each generator, so it is only given in total
+	if(global_sym_env!=NULL && !isnan(stats.rootLowerBound)){
+		lpBound=lpRelaxationBound(global_sym_env);
+		if(!isnan(lpBound))
+			rootGain=stats.rootLowerBound>lpBound?stats.rootLowerBound-lpBound:0;
+	}
+
+	//the table is stored column by column: cuts added, cuts added in the root, calls, time
+	for(iter=0;iter<NUM_CUT_GENERATORS;iter++){
+		table[iter]=stats.cutsGenerated[iter];
+		table[iter+NUM_CUT_GENERATORS]=stats.cutsInRoot[iter];
+		table[iter+2*NUM_CUT_GENERATORS]=stats.cutCalls[iter];
+		table[iter+3*NUM_CUT_GENERATORS]=stats.cutTime[iter];
+	}
+
+	sciprint("%-16s %10s %10s %8s %10s\n","generator","cuts","in root","calls","time");
+	for(iter=0;iter<NUM_CUT_GENERATORS;iter++)
+		if(stats.cutCalls[iter]>0 || stats.cutsGenerated[iter]>0)
+			sciprint("%-16s %10.0f %10.0f %8.0f %10.3f\n",cutGeneratorFields[iter],table[iter],
+				table[iter+NUM_CUT_GENERATORS],table[iter+2*NUM_CUT_GENERATORS],table[iter+3*NUM_CUT_GENERATORS]);
+	if(!isnan(rootGain))
+		sciprint("Root bound improved from %g (LP relaxation) to %g by the cuts.\n",lpBound,stats.rootLowerBound);
+
+	//code to give output
+	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,NUM_CUT_GENERATORS,NUM_CUT_STATS,table);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfString(pvApiCtx,nbInputArgument(pvApiCtx)+2,NUM_CUT_GENERATORS,1,cutGeneratorFields);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+3,rootGain))
+		return 1;
+	for(iter=1;iter<=nbOutputArgument(pvApiCtx);iter++)
+		AssignOutputVariable(pvApiCtx,iter)=nbInputArgument(pvApiCtx)+iter;
+
+	return 0;
+}
+
+}
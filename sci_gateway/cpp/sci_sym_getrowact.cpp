@@ -5,6 +5,7 @@
  */
 #include "symphony.h"
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
 
 extern sym_environment* global_sym_env; //defined in globals.cpp
 
@@ -22,8 +23,9 @@ int sci_sym_getRowActivity(char *fname){
 	int iRet;
 	
 	//data declarations
-	int numConstr;
-	double *rowAct;
+	int numConstr,numVars;
+	double *rowAct,objVal;
+	const double *colSol,*restored;
 	
 	//ensure that environment is active
 	if(global_sym_env==NULL){
@@ -35,33 +37,45 @@ int sci_sym_getRowActivity(char *fname){
 	CheckInputArgument(pvApiCtx,0,0) ;
 	CheckOutputArgument(pvApiCtx,1,1) ;
 	
-	//code to process input
-	iRet=sym_get_num_rows(global_sym_env,&numConstr);
-	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
-		Scierror(999, "An error occured. Has the problem been solved? Is the problem feasible?\n");
+	//a presolved problem gives the activity of the rows of the original problem
+	iRet=presolveRestoreSolution(global_sym_env,&numVars,&numConstr,&colSol,&restored,&objVal);
+	if(iRet<0){
+		Scierror(999, "An error occured while restoring the solution of the presolved problem. Has the problem been solved?\n");
 		return 1;
 	}
-	rowAct=new double[numConstr];
-	iRet=sym_get_row_activity(global_sym_env,rowAct);
+	if(iRet){
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numConstr,1,restored);
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			return 1;
+		}
+		AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx)+1;
+		return 0;
+	}
+
+	//code to process input
+	iRet=sym_get_num_rows(global_sym_env,&numConstr);
 	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
 		Scierror(999, "An error occured. Has the problem been solved? Is the problem feasible?\n");
-		delete[] rowAct;
 		return 1;
 	}
 	
-	//code to give output
-	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numConstr,1,rowAct);
+	//code to give output: symphony writes the activities straight into the output variable
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numConstr,1,&rowAct);
 	if (sciErr.iErr)
 	{
 		printError(&sciErr, 0);
-		delete[] rowAct;
+		return 1;
+	}
+	iRet=sym_get_row_activity(global_sym_env,rowAct);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has the problem been solved? Is the problem feasible?\n");
 		return 1;
 	}
 	AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx)+1;
 	//ReturnArguments(pvApiCtx);
 	
-	delete[] rowAct;
-	
 	return 0;
 }
 
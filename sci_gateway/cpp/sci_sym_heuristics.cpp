@@ -0,0 +1,600 @@
+/*
+ * Symphony Toolbox
+ * Primal heuristics run before the solve: LP rounding, a fix-and-propagate dive and a feasibility pump
+ * They work with Clp on the problem as Symphony holds it, in minimization form, and the best solution found
+ * is given to Symphony with sym_set_col_solution and sym_set_primal_bound
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_heuristics.hpp"
+#include "sci_sym_branching.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinFinite.hpp"
+#include "CoinError.hpp"
+#include <sys/time.h>
+#include <algorithm>
+#include <math.h>
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+}
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+#define HEURISTIC_TOLERANCE 1e-6
+#define PUMP_ITERATIONS 200
+#define PUMP_ALPHA_DECAY 0.9
+#define DEFAULT_TIME_LIMIT 10
+
+static bool heuristicsOn=false;
+static double heuristicsTime=DEFAULT_TIME_LIMIT;
+
+//the problem in minimization form, with infinite bounds as COIN_DBL_MAX
+struct heuristicProblem{
+	int numCols,numRows,objSense;
+	std::vector<double> lower,upper,objective,rowLower,rowUpper;
+	std::vector<char> isInt;
+	std::vector<int> intCols;
+	std::vector<int> downLocks,upLocks;	//rows that may be violated by decreasing/increasing a column
+	std::vector<double> priority;	//branching priority of each column, 0 if none is set
+	bool hasContinuous;
+	CoinPackedMatrix byCol,byRow;
+	OsiClpSolverInterface lp;
+	double startTime,timeLimit;
+	std::vector<double> best;
+	double bestValue;	//COIN_DBL_MAX while no solution is found
+	unsigned seed;
+};
+
+//a bound change of the dive, to be undone when backtracking
+struct boundChange{
+	int col;
+	double lower,upper;
+};
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+static bool timeLeft(const heuristicProblem &p)
+{
+	return wallClock()-p.startTime<p.timeLimit;
+}
+
+static bool loadHeuristicProblem(sym_environment *env, heuristicProblem &p)
+{
+	int numElements,iter,index;
+	double infinity=sym_get_infinity();
+	char isInt;
+	if(sym_get_num_cols(env,&p.numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(env,&p.numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_sense(env,&p.objSense)==FUNCTION_TERMINATED_ABNORMALLY)
+		return false;
+	std::vector<int> colStart(p.numCols+1),rowIndex(numElements+1);
+	std::vector<double> value(numElements+1);
+	p.lower.resize(p.numCols+1);
+	p.upper.resize(p.numCols+1);
+	p.objective.resize(p.numCols+1);
+	p.rowLower.resize(p.numRows+1);
+	p.rowUpper.resize(p.numRows+1);
+	if(sym_get_matrix(env,&numElements,&colStart[0],&rowIndex[0],&value[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_lower(env,&p.lower[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_upper(env,&p.upper[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_coeff(env,&p.objective[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		(p.numRows && sym_get_row_lower(env,&p.rowLower[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(p.numRows && sym_get_row_upper(env,&p.rowUpper[0])==FUNCTION_TERMINATED_ABNORMALLY))
+		return false;
+
+	p.isInt.assign(p.numCols,0);
+	p.priority.assign(p.numCols,0.0);
+	const std::vector<double> *priorities=branchingPriorities(env);
+	if(priorities)
+		std::copy(priorities->begin(),priorities->begin()+std::min(priorities->size(),(size_t)p.numCols),p.priority.begin());
+	p.hasContinuous=false;
+	//symphony gives the objective of a maximization negated, which is the minimization form already
+	for(iter=0;iter<p.numCols;iter++){
+		if(p.lower[iter]<=-infinity)
+			p.lower[iter]=-COIN_DBL_MAX;
+		if(p.upper[iter]>=infinity)
+			p.upper[iter]=COIN_DBL_MAX;
+		sym_is_integer(env,iter,&isInt);
+		if(isInt){
+			p.isInt[iter]=1;
+			p.intCols.push_back(iter);
+		}else
+			p.hasContinuous=true;
+	}
+	for(iter=0;iter<p.numRows;iter++){
+		if(p.rowLower[iter]<=-infinity)
+			p.rowLower[iter]=-COIN_DBL_MAX;
+		if(p.rowUpper[iter]>=infinity)
+			p.rowUpper[iter]=COIN_DBL_MAX;
+	}
+	p.byCol=CoinPackedMatrix(true,p.numRows,p.numCols,numElements,&value[0],&rowIndex[0],&colStart[0],NULL);
+	p.byRow.reverseOrderedCopyOf(p.byCol);
+
+	p.downLocks.assign(p.numCols,0);
+	p.upLocks.assign(p.numCols,0);
+	for(iter=0;iter<p.numCols;iter++)
+		for(index=colStart[iter];index<colStart[iter+1];index++){
+			bool hasLower=p.rowLower[rowIndex[index]]>-COIN_DBL_MAX,hasUpper=p.rowUpper[rowIndex[index]]<COIN_DBL_MAX;
+			if(value[index]>0 ? hasLower : hasUpper)
+				p.downLocks[iter]++;
+			if(value[index]>0 ? hasUpper : hasLower)
+				p.upLocks[iter]++;
+		}
+
+	p.lp.messageHandler()->setLogLevel(0);
+	p.lp.loadProblem(p.byCol,&p.lower[0],&p.upper[0],&p.objective[0],&p.rowLower[0],&p.rowUpper[0]);
+	p.lp.setObjSense(1);
+	return true;
+}
+
+static double objectiveValue(const heuristicProblem &p, const std::vector<double> &x)
+{
+	double value=0;
+	int iter;
+	for(iter=0;iter<p.numCols;iter++)
+		value+=p.objective[iter]*x[iter];
+	return value;
+}
+
+static bool isFeasible(const heuristicProblem &p, const std::vector<double> &x)
+{
+	std::vector<double> activity(p.numRows,0.0);
+	int iter;
+	for(iter=0;iter<p.numCols;iter++){
+		if(x[iter]<p.lower[iter]-HEURISTIC_TOLERANCE || x[iter]>p.upper[iter]+HEURISTIC_TOLERANCE)
+			return false;
+		if(p.isInt[iter] && fabs(x[iter]-floor(x[iter]+0.5))>HEURISTIC_TOLERANCE)
+			return false;
+	}
+	if(p.numRows)
+		p.byCol.times(&x[0],&activity[0]);
+	for(iter=0;iter<p.numRows;iter++)
+		if(activity[iter]<p.rowLower[iter]-HEURISTIC_TOLERANCE*(1+fabs(p.rowLower[iter])) ||
+			activity[iter]>p.rowUpper[iter]+HEURISTIC_TOLERANCE*(1+fabs(p.rowUpper[iter])))
+			return false;
+	return true;
+}
+
+//keep x if it is a feasible solution better than the best one
+static bool recordSolution(heuristicProblem &p, const std::vector<double> &x)
+{
+	double value;
+	if(!isFeasible(p,x))
+		return false;
+	value=objectiveValue(p,x);
+	if(value<p.bestValue){
+		p.best=x;
+		p.bestValue=value;
+	}
+	return true;
+}
+
+//complete the columns bounded by lower and upper into a solution, by solving the LP for the continuous columns
+static bool completeSolution(heuristicProblem &p, const std::vector<double> &lower, const std::vector<double> &upper)
+{
+	std::vector<double> x(lower.begin(),lower.begin()+p.numCols);
+	int iter;
+	bool solved;
+	if(!p.hasContinuous)
+		return recordSolution(p,x);
+	for(iter=0;iter<p.numCols;iter++)
+		p.lp.setColBounds(iter,lower[iter],upper[iter]);
+	p.lp.resolve();
+	solved=p.lp.isProvenOptimal();
+	if(solved){
+		x.assign(p.lp.getColSolution(),p.lp.getColSolution()+p.numCols);
+		for(iter=0;iter<p.numCols;iter++)
+			if(p.isInt[iter])
+				x[iter]=lower[iter];
+	}
+	for(iter=0;iter<p.numCols;iter++)
+		p.lp.setColBounds(iter,p.lower[iter],p.upper[iter]);
+	return solved && recordSolution(p,x);
+}
+
+static double roundInBounds(const heuristicProblem &p, int col, double value)
+{
+	value=floor(value+0.5);
+	if(value<p.lower[col])
+		value=ceil(p.lower[col]-HEURISTIC_TOLERANCE);
+	if(value>p.upper[col])
+		value=floor(p.upper[col]+HEURISTIC_TOLERANCE);
+	return value;
+}
+
+//round the fractional columns of the LP solution in a direction no row is locked in, if there is one
+static bool lpRounding(heuristicProblem &p, const std::vector<double> &relaxation)
+{
+	std::vector<double> lower(p.lower),upper(p.upper);
+	size_t iter;
+	for(iter=0;iter<p.intCols.size();iter++){
+		int col=p.intCols[iter];
+		double value=relaxation[col];
+		if(fabs(value-floor(value+0.5))>HEURISTIC_TOLERANCE){
+			if(p.downLocks[col]==0)
+				value=floor(value);
+			else if(p.upLocks[col]==0)
+				value=ceil(value);
+		}
+		lower[col]=upper[col]=roundInBounds(p,col,value);
+	}
+	return completeSolution(p,lower,upper);
+}
+
+static bool changeBounds(const heuristicProblem &p, std::vector<double> &lower, std::vector<double> &upper,
+	std::vector<boundChange> &trail, std::vector<int> &queue, std::vector<char> &inQueue, int col, double newLower, double newUpper)
+{
+	boundChange change={col,lower[col],upper[col]};
+	const int *rows=p.byCol.getIndices();
+	CoinBigIndex start=p.byCol.getVectorStarts()[col],end=start+p.byCol.getVectorLengths()[col],index;
+	if(newLower>newUpper+HEURISTIC_TOLERANCE)
+		return false;
+	trail.push_back(change);
+	lower[col]=newLower;
+	upper[col]=std::max(newLower,newUpper);
+	for(index=start;index<end;index++)
+		if(!inQueue[rows[index]]){
+			inQueue[rows[index]]=1;
+			queue.push_back(rows[index]);
+		}
+	return true;
+}
+
+//tighten the bounds with the rows in the queue until nothing changes, false if a row cannot be satisfied
+static bool propagate(const heuristicProblem &p, std::vector<double> &lower, std::vector<double> &upper,
+	std::vector<boundChange> &trail, std::vector<int> &queue, std::vector<char> &inQueue)
+{
+	const CoinBigIndex *rowStart=p.byRow.getVectorStarts();
+	const int *rowLength=p.byRow.getVectorLengths(),*cols=p.byRow.getIndices();
+	const double *elements=p.byRow.getElements();
+	double work=0,maxWork=20.0*p.byRow.getNumElements()+1000;
+	bool feasible=true;
+	size_t head;
+	for(head=0;head<queue.size();head++){
+		int row=queue[head],minInf=0,maxInf=0;
+		double minAct=0,maxAct=0;
+		CoinBigIndex index,end=rowStart[row]+rowLength[row];
+		inQueue[row]=0;
+		if(!feasible || work>maxWork)
+			continue;
+		work+=rowLength[row];
+
+		//activity bounds of the row, the infinite parts counted apart
+		for(index=rowStart[row];index<end;index++){
+			double a=elements[index],low=lower[cols[index]],up=upper[cols[index]];
+			if((a>0?low:up)>-COIN_DBL_MAX && (a>0?low:up)<COIN_DBL_MAX) minAct+=a*(a>0?low:up); else minInf++;
+			if((a>0?up:low)>-COIN_DBL_MAX && (a>0?up:low)<COIN_DBL_MAX) maxAct+=a*(a>0?up:low); else maxInf++;
+		}
+		if((minInf==0 && minAct>p.rowUpper[row]+HEURISTIC_TOLERANCE*(1+fabs(p.rowUpper[row]))) ||
+			(maxInf==0 && maxAct<p.rowLower[row]-HEURISTIC_TOLERANCE*(1+fabs(p.rowLower[row])))){
+			feasible=false;
+			continue;
+		}
+
+		//bounds of each column implied by the others
+		for(index=rowStart[row];index<end && feasible;index++){
+			int col=cols[index];
+			double a=elements[index],low=lower[col],up=upper[col],newLower=low,newUpper=up;
+			double minPart=a>0?low:up,maxPart=a>0?up:low;
+			bool minPartInf=!(minPart>-COIN_DBL_MAX && minPart<COIN_DBL_MAX),maxPartInf=!(maxPart>-COIN_DBL_MAX && maxPart<COIN_DBL_MAX);
+			if(p.rowUpper[row]<COIN_DBL_MAX && (minInf==0 || (minInf==1 && minPartInf))){
+				double bound=(p.rowUpper[row]-(minAct-(minPartInf?0:a*minPart)))/a;
+				if(a>0) newUpper=std::min(newUpper,bound); else newLower=std::max(newLower,bound);
+			}
+			if(p.rowLower[row]>-COIN_DBL_MAX && (maxInf==0 || (maxInf==1 && maxPartInf))){
+				double bound=(p.rowLower[row]-(maxAct-(maxPartInf?0:a*maxPart)))/a;
+				if(a>0) newLower=std::max(newLower,bound); else newUpper=std::min(newUpper,bound);
+			}
+			if(p.isInt[col]){
+				newLower=ceil(newLower-HEURISTIC_TOLERANCE);
+				newUpper=floor(newUpper+HEURISTIC_TOLERANCE);
+			}else{
+				//small changes of continuous bounds are not worth going round the rows again
+				if(newLower<low+1e-3*std::max(1.0,fabs(low))) newLower=low;
+				if(newUpper>up-1e-3*std::max(1.0,fabs(up))) newUpper=up;
+			}
+			if(newLower>low || newUpper<up)
+				feasible=changeBounds(p,lower,upper,trail,queue,inQueue,col,std::max(newLower,low),std::min(newUpper,up));
+		}
+	}
+	queue.clear();
+	return feasible;
+}
+
+static void undoBounds(std::vector<double> &lower, std::vector<double> &upper, std::vector<boundChange> &trail, size_t mark)
+{
+	while(trail.size()>mark){
+		lower[trail.back().col]=trail.back().lower;
+		upper[trail.back().col]=trail.back().upper;
+		trail.pop_back();
+	}
+}
+
+//the column of highest priority first, then the least fractional one
+struct fixingOrder{
+	const std::vector<double> *relaxation,*priority;
+	bool operator()(int first, int second) const{
+		double a=(*relaxation)[first],b=(*relaxation)[second];
+		if((*priority)[first]!=(*priority)[second])
+			return (*priority)[first]>(*priority)[second];
+		return fabs(a-floor(a+0.5))<fabs(b-floor(b+0.5));
+	}
+};
+
+//fix the integer columns one by one at the rounding of the LP solution, by priority and the least fractional first,
+//propagating each fixing through the rows and trying the other rounding when it leads to a contradiction
+static bool fixAndPropagate(heuristicProblem &p, const std::vector<double> &relaxation)
+{
+	std::vector<double> lower(p.lower),upper(p.upper);
+	std::vector<boundChange> trail;
+	std::vector<int> queue,order(p.intCols);
+	std::vector<char> inQueue(p.numRows,1);
+	fixingOrder compare;
+	size_t iter;
+	int row;
+	for(row=0;row<p.numRows;row++)
+		queue.push_back(row);
+	if(!propagate(p,lower,upper,trail,queue,inQueue))
+		return false;
+	compare.relaxation=&relaxation;
+	compare.priority=&p.priority;
+	std::stable_sort(order.begin(),order.end(),compare);
+	for(iter=0;iter<order.size();iter++){
+		int col=order[iter];
+		double value,other;
+		size_t mark=trail.size();
+		if(upper[col]-lower[col]<0.5)
+			continue;
+		if(!timeLeft(p))
+			return false;
+		value=floor(relaxation[col]+0.5);
+		value=std::min(std::max(value,lower[col]),upper[col]);
+		if(changeBounds(p,lower,upper,trail,queue,inQueue,col,value,value) && propagate(p,lower,upper,trail,queue,inQueue))
+			continue;
+		queue.clear();
+		undoBounds(lower,upper,trail,mark);
+		other=relaxation[col]>=value?value+1:value-1;
+		if(other<lower[col] || other>upper[col])
+			return false;
+		if(!changeBounds(p,lower,upper,trail,queue,inQueue,col,other,other) || !propagate(p,lower,upper,trail,queue,inQueue))
+			return false;
+	}
+	return completeSolution(p,lower,upper);
+}
+
+//alternate between rounding the LP solution and finding the LP solution closest to the rounding,
+//with a decreasing share of the objective; a rounding that comes back is perturbed
+static bool feasibilityPump(heuristicProblem &p, const std::vector<double> &relaxation)
+{
+	std::vector<double> x(relaxation),rounded(p.numCols),previous,lower(p.lower),upper(p.upper),objective(p.numCols);
+	std::vector<std::pair<double,int> > distance;
+	double norm=0,scale,alpha=1;
+	size_t iter;
+	int pass;
+	bool found=false;
+	for(iter=0;iter<(size_t)p.numCols;iter++)
+		norm+=p.objective[iter]*p.objective[iter];
+	scale=norm>0?sqrt((double)p.intCols.size()/norm):0;
+
+	for(pass=0;pass<PUMP_ITERATIONS && !found && timeLeft(p);pass++){
+		for(iter=0;iter<p.intCols.size();iter++)
+			rounded[p.intCols[iter]]=roundInBounds(p,p.intCols[iter],x[p.intCols[iter]]);
+		if(rounded==previous){
+			//flip the columns that are furthest from their rounding, between 10 and 30 of them
+			distance.clear();
+			for(iter=0;iter<p.intCols.size();iter++){
+				int col=p.intCols[iter];
+				distance.push_back(std::make_pair(-fabs(x[col]-rounded[col]),col));
+			}
+			std::sort(distance.begin(),distance.end());
+			p.seed=p.seed*1103515245+12345;
+			size_t flips=std::min(distance.size(),(size_t)(10+(p.seed>>16)%21));
+			for(iter=0;iter<flips;iter++){
+				int col=distance[iter].second;
+				double flipped=x[col]>rounded[col]?rounded[col]+1:rounded[col]-1;
+				if(flipped<p.lower[col]-HEURISTIC_TOLERANCE || flipped>p.upper[col]+HEURISTIC_TOLERANCE)
+					flipped=x[col]>rounded[col]?rounded[col]-1:rounded[col]+1;
+				if(flipped>=p.lower[col]-HEURISTIC_TOLERANCE && flipped<=p.upper[col]+HEURISTIC_TOLERANCE)
+					rounded[col]=flipped;
+			}
+		}
+		previous=rounded;
+		for(iter=0;iter<p.intCols.size();iter++)
+			lower[p.intCols[iter]]=upper[p.intCols[iter]]=rounded[p.intCols[iter]];
+		if(completeSolution(p,lower,upper)){
+			found=true;
+			break;
+		}
+
+		//distance to the rounding, for the integer columns at one of their bounds
+		for(iter=0;iter<(size_t)p.numCols;iter++)
+			objective[iter]=alpha*scale*p.objective[iter];
+		for(iter=0;iter<p.intCols.size();iter++){
+			int col=p.intCols[iter];
+			if(rounded[col]<=p.lower[col])
+				objective[col]+=1-alpha;
+			else if(rounded[col]>=p.upper[col])
+				objective[col]-=1-alpha;
+		}
+		alpha*=PUMP_ALPHA_DECAY;
+		p.lp.setObjective(&objective[0]);
+		p.lp.resolve();
+		if(!p.lp.isProvenOptimal())
+			break;
+		x.assign(p.lp.getColSolution(),p.lp.getColSolution()+p.numCols);
+	}
+	p.lp.setObjective(&p.objective[0]);
+	return found;
+}
+
+static void reportHeuristic(const heuristicProblem &p, const char *name, bool found, double startTime)
+{
+	if(found)
+		sciprint("%-20s solution of value %g, best %g, in %.3f s\n",name,p.objSense*objectiveValue(p,p.best),
+			p.objSense*p.bestValue,wallClock()-startTime);
+	else
+		sciprint("%-20s no solution, in %.3f s\n",name,wallClock()-startTime);
+}
+
+int heuristicsRun(sym_environment *env, double timeLimit, std::vector<double> *solution, double *objValue)
+{
+	heuristicProblem p;
+	double startTime,bestValue;
+	bool found;
+	p.startTime=wallClock();
+	p.timeLimit=timeLimit;
+	p.bestValue=COIN_DBL_MAX;
+	p.seed=1;
+	if(!loadHeuristicProblem(env,p) || p.intCols.empty())
+		return 0;
+	try{
+		p.lp.initialSolve();
+		if(!p.lp.isProvenOptimal()){
+			sciprint("Heuristics: the LP relaxation could not be solved.\n");
+			return 0;
+		}
+		std::vector<double> relaxation(p.lp.getColSolution(),p.lp.getColSolution()+p.numCols);
+
+		startTime=wallClock();
+		found=lpRounding(p,relaxation);
+		reportHeuristic(p,"LP rounding:",found,startTime);
+		if(timeLeft(p)){
+			startTime=wallClock();
+			found=fixAndPropagate(p,relaxation);
+			reportHeuristic(p,"Fix and propagate:",found,startTime);
+		}
+		if(timeLeft(p)){
+			startTime=wallClock();
+			found=feasibilityPump(p,relaxation);
+			reportHeuristic(p,"Feasibility pump:",found,startTime);
+		}
+	}catch(CoinError &error){
+		sciprint("Heuristics: %s\n",error.message().c_str());
+	}
+	if(p.bestValue==COIN_DBL_MAX){
+		sciprint("The heuristics found no solution in %.3f s.\n",wallClock()-p.startTime);
+		return 0;
+	}
+
+	bestValue=p.objSense*p.bestValue;
+	if(sym_set_col_solution(env,&p.best[0])==FUNCTION_TERMINATED_ABNORMALLY)
+		sciprint("Warning: Symphony did not take the solution of the heuristics.\n");
+	else
+		sym_set_primal_bound(env,bestValue);
+	sciprint("The heuristics found a solution of value %g in %.3f s.\n",bestValue,wallClock()-p.startTime);
+	if(solution)
+		*solution=p.best;
+	if(objValue)
+		*objValue=bestValue;
+	return 1;
+}
+
+int heuristicsEnabled()
+{
+	return heuristicsOn;
+}
+
+double heuristicsTimeLimit()
+{
+	return heuristicsTime;
+}
+
+extern "C" {
+
+int sci_sym_setHeuristics(char *fname){
+
+	//data declarations
+	double enable,timeLimit=DEFAULT_TIME_LIMIT;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,2) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: whether sym_solve runs the heuristics first
+	if(getDoubleFromScilab(1,&enable))
+		return 1;
+	//get input 2: time limit of the heuristics in seconds
+	if(nbInputArgument(pvApiCtx)==2 && getDoubleFromScilab(2,&timeLimit))
+		return 1;
+	if(timeLimit<=0){
+		Scierror(999, "Wrong value for input argument #2: A positive time limit is expected.\n");
+		return 1;
+	}
+	heuristicsOn=(enable!=0);
+	heuristicsTime=timeLimit;
+	if(heuristicsOn)
+		sciprint("sym_solve will run the heuristics for at most %g s before solving.\n",heuristicsTime);
+	else
+		sciprint("sym_solve will not run the heuristics.\n");
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_runHeuristics(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	double timeLimit=heuristicsTime,objValue;
+	std::vector<double> solution;
+	int found;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,1) ;
+	CheckOutputArgument(pvApiCtx,1,2) ;
+
+	//get input 1: time limit in seconds
+	if(nbInputArgument(pvApiCtx)==1 && getDoubleFromScilab(1,&timeLimit))
+		return 1;
+	if(timeLimit<=0){
+		Scierror(999, "Wrong value for input argument #1: A positive time limit is expected.\n");
+		return 1;
+	}
+	if(sym_get_num_cols(global_sym_env,&found)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "No problem is loaded. Please load a problem first.\n");
+		return 1;
+	}
+	found=heuristicsRun(global_sym_env,timeLimit,&solution,&objValue);
+
+	//code to give output: empty matrices if no solution was found
+	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,found,found,&objValue);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,found,found?solution.size():0,found?&solution[0]:NULL);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+	AssignOutputVariable(pvApiCtx,2)=nbInputArgument(pvApiCtx)+2;
+
+	return 0;
+}
+
+}
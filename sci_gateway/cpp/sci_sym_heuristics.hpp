@@ -0,0 +1,22 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for finding a solution of the loaded problem before it is solved
+// LP rounding, a feasibility pump and a fix-and-propagate dive are run with Clp, and the best
+// solution found is given to Symphony as its first incumbent
+
+#ifndef SCI_SYMHEURISTICSHEADER
+#define SCI_SYMHEURISTICSHEADER
+
+#include "symphony.h"
+
+#include <vector>
+
+//run the heuristics on the problem in env for at most timeLimit seconds
+//returns 1 if a solution was found, in which case it is given to env and, unless they are NULL,
+//stored in solution with its objective value in objValue, and 0 otherwise
+int heuristicsRun(sym_environment *env, double timeLimit, std::vector<double> *solution, double *objValue);
+
+//whether sym_solve runs the heuristics first, and for how long
+int heuristicsEnabled();
+double heuristicsTimeLimit();
+
+#endif //SCI_SYMHEURISTICSHEADER
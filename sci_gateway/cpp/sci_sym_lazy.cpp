@@ -0,0 +1,387 @@
+/*
+ * Symphony Toolbox
+ * Lazy constraints: rows kept out of the problem until a solution violates them
+ * Symphony's cut generation is compiled into the library, so the violated rows are separated from each
+ * solution and added to the problem, which is then solved again from scratch
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_progress.hpp"
+#include "sci_sym_lazy.hpp"
+#include <map>
+#include <vector>
+#include <math.h>
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+int process_ret_val(int);
+int interruptible_solve(sym_environment*,int);
+}
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+//the lazy constraints of a problem, row by row, and the edges checked by the subtour separator
+struct lazyPool{
+	int numVars;
+	std::vector<int> rowStart,colIndex;
+	std::vector<double> elements,lower,upper;
+	std::vector<char> added; //whether the row is already in the problem
+	int numNodes;
+	std::vector<int> edgeVars,tails,heads;
+};
+
+static std::map<sym_environment*,lazyPool> lazyPools;
+
+void lazyForget(sym_environment *env)
+{
+	lazyPools.erase(env);
+}
+
+//the pool of env for a problem with numVars variables; it is kept when variables have been added since,
+//as by sym_addSOS, and made empty if it has none or was made for a problem with more variables
+static lazyPool &lazyPoolFor(sym_environment *env, int numVars)
+{
+	lazyPool &pool=lazyPools[env];
+	if(pool.rowStart.empty() || pool.numVars>numVars){
+		pool=lazyPool();
+		pool.numNodes=0;
+		pool.rowStart.push_back(0);
+	}
+	pool.numVars=numVars;
+	return pool;
+}
+
+//add a row with the given bounds to the problem, deducing its type as in sym_loadProblem
+static int addBoundedRow(sym_environment *env, int numElements, int *indices, double *elements, double lower, double upper)
+{
+	char type;
+	double rhs,range=0;
+	if(lower==(-INFINITY) && upper==INFINITY){
+		type='N';
+		rhs=0;
+	}else if(lower==(-INFINITY)){
+		type='L';
+		rhs=upper;
+	}else if(upper==INFINITY){
+		type='G';
+		rhs=lower;
+	}else if(upper==lower){
+		type='E';
+		rhs=lower;
+	}else{
+		type='R';
+		range=upper-lower;
+		rhs=upper;
+	}
+	return sym_add_row(env,numElements,indices,elements,type,rhs,range);
+}
+
+//move the rows of the pool violated by solution into the problem, returns how many were moved or -1 on error
+static int separatePool(sym_environment *env, lazyPool &pool, const double *solution)
+{
+	int numAdded=0,row,iter;
+	for(row=0;row+1<(int)pool.rowStart.size();row++){
+		double activity=0,lower=pool.lower[row],upper=pool.upper[row];
+		if(pool.added[row])
+			continue;
+		for(iter=pool.rowStart[row];iter<pool.rowStart[row+1];iter++)
+			activity+=pool.elements[iter]*solution[pool.colIndex[iter]];
+		if(activity>=lower-1e-6*(1+fabs(lower)) && activity<=upper+1e-6*(1+fabs(upper)))
+			continue;
+		if(addBoundedRow(env,pool.rowStart[row+1]-pool.rowStart[row],&pool.colIndex[pool.rowStart[row]],
+			&pool.elements[pool.rowStart[row]],lower,upper)==FUNCTION_TERMINATED_ABNORMALLY)
+			return -1;
+		pool.added[row]=1;
+		numAdded++;
+	}
+	return numAdded;
+}
+
+static int findNode(std::vector<int> &parent, int node)
+{
+	while(parent[node]!=node){
+		parent[node]=parent[parent[node]];
+		node=parent[node];
+	}
+	return node;
+}
+
+//add x(E(S)) <= |S|-1 for each set S of nodes that the chosen edges of solution join into a subtour,
+//returns how many rows were added or -1 on error
+static int separateSubtours(sym_environment *env, const lazyPool &pool, const double *solution)
+{
+	int numAdded=0,node,edge,numEdges=pool.edgeVars.size(),numComponents=0;
+	std::vector<int> parent(pool.numNodes),size(pool.numNodes,0);
+	for(node=0;node<pool.numNodes;node++)
+		parent[node]=node;
+	for(edge=0;edge<numEdges;edge++)
+		if(solution[pool.edgeVars[edge]]>0.5)
+			parent[findNode(parent,pool.tails[edge])]=findNode(parent,pool.heads[edge]);
+	for(node=0;node<pool.numNodes;node++)
+		if(size[findNode(parent,node)]++==0)
+			numComponents++;
+	if(numComponents<2)
+		return 0;
+
+	//the edges inside each subtour, gathered by the root of its nodes
+	std::map<int,std::vector<int> > inside;
+	for(edge=0;edge<numEdges;edge++){
+		int root=findNode(parent,pool.tails[edge]);
+		if(root==findNode(parent,pool.heads[edge]))
+			inside[root].push_back(pool.edgeVars[edge]);
+	}
+	for(std::map<int,std::vector<int> >::iterator subtour=inside.begin();subtour!=inside.end();++subtour){
+		if(size[subtour->first]<2)
+			continue;
+		std::vector<double> ones(subtour->second.size(),1.0);
+		if(sym_add_row(env,subtour->second.size(),&subtour->second[0],&ones[0],'L',size[subtour->first]-1,0)==FUNCTION_TERMINATED_ABNORMALLY)
+			return -1;
+		numAdded++;
+	}
+	return numAdded;
+}
+
+extern "C" {
+
+int sci_sym_addLazyConstrs(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+	int iRet;
+
+	//data declarations
+	int *varAddress,numVars,nonZeros,*itemsPerRow,*colIndex,inputRows,inputCols,rowIter,arrayIter;
+	double *matrix,*conLower,*conUpper;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,3,3) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get number of columns
+	iRet=sym_get_num_cols(global_sym_env,&numVars);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: sparse matrix of variable coefficients, one row per lazy constraint
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isSparseType(pvApiCtx,varAddress) ||  isVarComplex(pvApiCtx,varAddress) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A sparse matrix of doubles is expected.\n");
+		return 1;
+	}
+	sciErr = getSparseMatrix(pvApiCtx,varAddress,&inputRows,&inputCols,&nonZeros,&itemsPerRow,&colIndex,&matrix);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(inputCols!=numVars)
+	{
+		Scierror(999, "Wrong type for input argument #1: Incorrectly sized matrix.\n");
+		return 1;
+	}
+
+	//get input 2: lower bounds of the lazy constraints
+	if(getFixedSizeDoubleMatrixFromScilab(2,inputRows,1,&conLower))
+		return 1;
+
+	//get input 3: upper bounds of the lazy constraints
+	if(getFixedSizeDoubleMatrixFromScilab(3,inputRows,1,&conUpper))
+		return 1;
+	for(rowIter=0;rowIter<inputRows;rowIter++)
+		if(conLower[rowIter]>conUpper[rowIter])
+		{
+			Scierror(999, "Error: the lower bound of constraint %d is more than its upper bound.\n",rowIter);
+			return 1;
+		}
+
+	//scilab stores sparse matrices row by row with 1-based column indices
+	lazyPool &pool=lazyPoolFor(global_sym_env,numVars);
+	for(rowIter=0,arrayIter=0;rowIter<inputRows;rowIter++)
+	{
+		for(int iter=0;iter<itemsPerRow[rowIter];iter++,arrayIter++){
+			pool.colIndex.push_back(colIndex[arrayIter]-1);
+			pool.elements.push_back(matrix[arrayIter]);
+		}
+		pool.rowStart.push_back(pool.colIndex.size());
+		pool.lower.push_back(conLower[rowIter]);
+		pool.upper.push_back(conUpper[rowIter]);
+		pool.added.push_back(0);
+	}
+	sciprint("%d lazy constraints added to the pool, which now has %d.\n",inputRows,(int)pool.lower.size());
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_setSubtourSeparator(char *fname){
+
+	//data declarations
+	int numVars,rows,cols,numEdges,iter;
+	double *vars,*tails,*heads;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,3,3) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: the variable of each edge, an empty matrix removes the separator
+	if(getDoubleMatrixFromScilab(1,&rows,&cols,&vars))
+		return 1;
+	numEdges=rows*cols;
+	for(iter=0;iter<numEdges;iter++)
+		if(vars[iter]<0 || vars[iter]>=numVars || vars[iter]!=(int)vars[iter]){
+			Scierror(999, "Wrong value for input argument #1: Entry %d must be a whole number between 0 and %d.\n",iter+1,numVars-1);
+			return 1;
+		}
+
+	//get inputs 2 and 3: the nodes at the ends of each edge
+	if(getFixedSizeDoubleMatrixFromScilab(2,rows,cols,&tails) || getFixedSizeDoubleMatrixFromScilab(3,rows,cols,&heads))
+		return 1;
+
+	lazyPool &pool=lazyPoolFor(global_sym_env,numVars);
+	pool.numNodes=0;
+	pool.edgeVars.clear();
+	pool.tails.clear();
+	pool.heads.clear();
+	for(iter=0;iter<numEdges;iter++){
+		if(tails[iter]<0 || tails[iter]!=(int)tails[iter] || heads[iter]<0 || heads[iter]!=(int)heads[iter]){
+			pool.edgeVars.clear();
+			Scierror(999, "Wrong value for input arguments #2 and #3: The nodes of edge %d must be whole numbers from 0.\n",iter+1);
+			return 1;
+		}
+		pool.edgeVars.push_back((int)vars[iter]);
+		pool.tails.push_back((int)tails[iter]);
+		pool.heads.push_back((int)heads[iter]);
+		if(pool.tails.back()>=pool.numNodes)
+			pool.numNodes=pool.tails.back()+1;
+		if(pool.heads.back()>=pool.numNodes)
+			pool.numNodes=pool.heads.back()+1;
+	}
+	if(numEdges==0)
+		pool.numNodes=0;
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_solveLazy(char *fname){
+
+	//data declarations
+	int numVars,status,rounds=0,maxRounds=-1,numAdded=0,newRows=0,capturing;
+	double maxRoundsInput;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,1) ;
+	CheckOutputArgument(pvApiCtx,1,2) ;
+
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: the most solves made after the first one, no limit by default
+	if(nbInputArgument(pvApiCtx)==1){
+		if(getDoubleFromScilab(1,&maxRoundsInput))
+			return 1;
+		if(maxRoundsInput<0 || maxRoundsInput!=(int)maxRoundsInput){
+			Scierror(999, "Wrong value for input argument #1: A non-negative whole number is expected.\n");
+			return 1;
+		}
+		maxRounds=(int)maxRoundsInput;
+	}
+	lazyPool &pool=lazyPoolFor(global_sym_env,numVars);
+
+	capturing=progressBegin(global_sym_env);
+	status=interruptible_solve(global_sym_env,0);
+	std::vector<double> solution(numVars);
+	while(status!=TM_SIGNAL_CAUGHT && status!=TM_NO_SOLUTION && status!=PREP_NO_SOLUTION &&
+		sym_get_col_solution(global_sym_env,&solution[0])!=FUNCTION_TERMINATED_ABNORMALLY){
+		//the rows violated by the solution are added, the others stay out of the problem
+		newRows=separatePool(global_sym_env,pool,&solution[0]);
+		if(newRows>=0 && !pool.edgeVars.empty()){
+			int subtours=separateSubtours(global_sym_env,pool,&solution[0]);
+			newRows=(subtours<0)?subtours:newRows+subtours;
+		}
+		if(newRows<=0)
+			break;
+		numAdded+=newRows;
+		if(rounds==maxRounds)
+			break;
+		rounds++;
+		//sym_add_row does not mark the warm start as changed, which would prune the tree of the tighter
+		//problem against the bound and incumbent of the looser one, so each solve starts from scratch
+		status=interruptible_solve(global_sym_env,0);
+	}
+	if(capturing)
+		progressEnd();
+
+	if(newRows<0){
+		Scierror(999, "An error occured while adding the lazy constraints to the problem.\n");
+		return 1;
+	}
+	sciprint("\n%d lazy constraints were added in %d solves after the first one.",numAdded,rounds);
+	if(newRows>0)
+		sciprint("\nThe limit on solves was reached: the solution violates the last %d of them.",newRows);
+	status=process_ret_val(status);
+
+	//code to give output
+	if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,status))
+		return 1;
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+	if(nbOutputArgument(pvApiCtx)==2){
+		if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,numAdded))
+			return 1;
+		AssignOutputVariable(pvApiCtx,2)=nbInputArgument(pvApiCtx)+2;
+	}
+
+	return 0;
+}
+
+}
@@ -0,0 +1,14 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for lazy constraints
+// The lazy constraints of each environment are kept in a pool and only added to the problem when
+// a solution violates them
+
+#ifndef SCI_SYMLAZYHEADER
+#define SCI_SYMLAZYHEADER
+
+#include "symphony.h"
+
+//forget the lazy constraints and the subtour separator of env, to be called when env is closed
+void lazyForget(sym_environment *env);
+
+#endif //SCI_SYMLAZYHEADER
@@ -64,6 +64,8 @@ int sci_sym_load_mps(char *fname, unsigned long fname_len){
 			sciprint("File read successfully\n");
 		}
 	}
+	if(!err)
+		freeAllocatedSingleString(ptr);
 
 	if(returnDoubleToScilab(status))
 		return 1;
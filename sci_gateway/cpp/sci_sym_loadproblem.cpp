@@ -5,6 +5,8 @@
  */
 #include "symphony.h"
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_blocks.hpp"
 
 extern sym_environment* global_sym_env; //defined in globals.cpp
 
@@ -224,9 +226,18 @@ static int commonCodePart2()
 	*/
 	
 	//call problem loader
-	sym_explicit_load_problem(global_sym_env,numVars,numConstr,conMatrixColStart,conMatrixRowIndex,conMatrix,lowerBounds,upperBounds,isIntVar,objective,NULL,conType,conRHS,conRange,TRUE);
+	presolveLoadProblem(global_sym_env,numVars,numConstr,conMatrixColStart,conMatrixRowIndex,conMatrix,lowerBounds,upperBounds,isIntVar,objective,conType,conRHS,conRange,(int)objSense);
 	sciprint("Problem loaded into environment.\n");
 	
+	//tell about independent blocks, which sym_solveBlocks solves apart
+	if(numVars>0)
+	{
+		std::vector<int> colBlock,rowBlock;
+		int numBlocks=blocksFind(numVars,numConstr,conMatrixColStart,conMatrixRowIndex,colBlock,rowBlock);
+		if(numBlocks>1)
+			sciprint("The problem has %d independent blocks, sym_solveBlocks() can solve them in parallel.\n",numBlocks);
+	}
+	
 	//code to give output
 	cleanupBeforeExit();
 	
@@ -0,0 +1,210 @@
+/*
+ * Symphony Toolbox
+ * Functions for reading and writing problems in CPLEX LP format, using CoinLpIO
+ * A problem read is loaded directly with sym_explicit_load_problem, without going through MPS
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "CoinLpIO.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinError.hpp"
+#include <sys/time.h>
+#include <vector>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+#include <math.h>
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+//get the name of the file from input 1, to be freed with freeAllocatedSingleString
+static int getFileNameFromScilab(char **fileName)
+{
+	SciErr sciErr;
+	int *varAddress;
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A file name is expected.\n");
+		return 1;
+	}
+	return 0;
+}
+
+int sci_sym_loadLP(char *fname){
+
+	//data declarations
+	char *fileName=NULL;
+	int numCols,numRows,iter;
+	double startTime=wallClock(),readTime,infinity;
+	CoinLpIO lp;
+	FILE *file;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: name of the file to read
+	if(getFileNameFromScilab(&fileName))
+		return 1;
+	file=fopen(fileName,"r");
+	if(file==NULL){
+		Scierror(999, "Unable to read file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	try{
+		lp.readLp(file);
+	}catch(CoinError &error){
+		fclose(file);
+		freeAllocatedSingleString(fileName);
+		Scierror(999, "Error while reading file: %s\n",error.message().c_str());
+		return 1;
+	}
+	fclose(file);
+	freeAllocatedSingleString(fileName);
+	readTime=wallClock()-startTime;
+
+	//CoinLpIO gives the matrix, bounds and constraints in the form symphony expects, only infinity differs
+	numCols=lp.getNumCols();
+	numRows=lp.getNumRows();
+	infinity=lp.getInfinity();
+	CoinPackedMatrix matrix(*lp.getMatrixByCol());
+	matrix.removeGaps();
+	std::vector<double> lower(lp.getColLower(),lp.getColLower()+numCols),upper(lp.getColUpper(),lp.getColUpper()+numCols);
+	std::vector<double> rowRHS(lp.getRightHandSide(),lp.getRightHandSide()+numRows);
+	std::vector<double> rowRange(lp.getRowRange(),lp.getRowRange()+numRows);
+	std::vector<char> rowSense(lp.getRowSense(),lp.getRowSense()+numRows);
+	std::vector<char> isInt(numCols,FALSE);
+	for(iter=0;iter<numCols;iter++){
+		if(lower[iter]<=-infinity)
+			lower[iter]=-INFINITY;
+		if(upper[iter]>=infinity)
+			upper[iter]=INFINITY;
+		isInt[iter]=lp.isInteger(iter)?TRUE:FALSE;
+	}
+	presolveLoadProblem(global_sym_env,numCols,numRows,(int*)matrix.getVectorStarts(),(int*)matrix.getIndices(),
+		(double*)matrix.getElements(),numCols?&lower[0]:NULL,numCols?&upper[0]:NULL,numCols?&isInt[0]:NULL,
+		(double*)lp.getObjCoefficients(),numRows?&rowSense[0]:NULL,numRows?&rowRHS[0]:NULL,numRows?&rowRange[0]:NULL,1);
+	sym_set_obj_sense(global_sym_env,1);
+	//a presolved problem has other columns, the names do not apply to it
+	if(sym_get_num_cols(global_sym_env,&iter)!=FUNCTION_TERMINATED_ABNORMALLY && iter==numCols)
+		sym_set_col_names(global_sym_env,(char**)lp.getColNames());
+	if(lp.objectiveOffset()!=0)
+		sciprint("Warning: the constant term %g of the objective is ignored.\n",lp.objectiveOffset());
+	sciprint("File read successfully: %d constraints, %d variables, %d nonzeros in %.3f s (%.0f nonzeros/s), loaded in %.3f s.\n",
+		numRows,numCols,matrix.getNumElements(),readTime,readTime>0?matrix.getNumElements()/readTime:0.0,wallClock()-startTime-readTime);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_saveLP(char *fname){
+
+	//data declarations
+	char *fileName=NULL;
+	int numCols,numRows,numElements,iter,objSense,iRet;
+	double startTime=wallClock();
+	char isInt;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(sym_get_num_cols(global_sym_env,&numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(global_sym_env,&numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(global_sym_env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "No problem is loaded. Please load a problem first.\n");
+		return 1;
+	}
+
+	//get the whole problem from symphony
+	std::vector<int> colStart(numCols+1),rowIndex(numElements+1);
+	std::vector<double> value(numElements+1),lower(numCols+1),upper(numCols+1),objective(numCols+1);
+	std::vector<double> rowLower(numRows+1),rowUpper(numRows+1);
+	std::vector<char> integrality(numCols+1);
+	if(sym_get_matrix(global_sym_env,&numElements,&colStart[0],&rowIndex[0],&value[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_lower(global_sym_env,&lower[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_upper(global_sym_env,&upper[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_coeff(global_sym_env,&objective[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		(numRows && sym_get_row_lower(global_sym_env,&rowLower[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(numRows && sym_get_row_upper(global_sym_env,&rowUpper[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		sym_get_obj_sense(global_sym_env,&objSense)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured while getting the problem from Symphony.\n");
+		return 1;
+	}
+	for(iter=0;iter<numCols;iter++){
+		sym_is_integer(global_sym_env,iter,&isInt);
+		integrality[iter]=isInt?1:0;
+	}
+
+	//the LP format of CoinLpIO only has minimization; symphony gives the objective of a maximization negated already
+	if(objSense==-1)
+		sciprint("Warning: the problem is a maximization, the objective is written negated as a minimization.\n");
+
+	//get input 1: name of the file to write
+	if(getFileNameFromScilab(&fileName))
+		return 1;
+	try{
+		CoinLpIO lp;
+		CoinPackedMatrix matrix(true,numRows,numCols,numElements,&value[0],&rowIndex[0],&colStart[0],NULL);
+		lp.setInfinity(sym_get_infinity());
+		lp.setLpDataWithoutRowAndColNames(matrix,&lower[0],&upper[0],&objective[0],&integrality[0],&rowLower[0],&rowUpper[0]);
+		lp.setLpDataRowAndColNames(NULL,NULL);
+		iRet=lp.writeLp(fileName);
+	}catch(CoinError &error){
+		freeAllocatedSingleString(fileName);
+		Scierror(999, "Error while writing file: %s\n",error.message().c_str());
+		return 1;
+	}
+	if(iRet){
+		Scierror(999, "Unable to write file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	freeAllocatedSingleString(fileName);
+	sciprint("File written successfully: %d nonzeros in %.3f s.\n",numElements,wallClock()-startTime);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+}
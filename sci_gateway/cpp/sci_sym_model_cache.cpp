@@ -0,0 +1,357 @@
+/*
+ * Symphony Toolbox
+ * Cache of environments with a loaded problem, found by a fingerprint of the problem data
+ * symphony_call uses it so that solving the same problem again does not load it again
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_branching.hpp"
+#include "sci_sym_lazy.hpp"
+#include <stdint.h>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+#include <string.h>
+
+void threadsSetDefault(sym_environment *env); //defined in sci_sym_threads.cpp
+void forgetEnvironment(sym_environment *env); //defined in sci_sym_openclose.cpp
+
+#define MODEL_CACHE_SIZE 4
+
+struct modelCacheEntry{
+	sym_environment *env;	//NULL if the entry is free
+	uint64_t fingerprint;
+	uint64_t digest;	//of the problem in env when it was stored
+	unsigned lastUse;
+};
+
+static modelCacheEntry modelCache[MODEL_CACHE_SIZE];
+static unsigned modelCacheClock=0;
+
+//called by sym_close, so that a closed environment is not handed out again
+void modelCacheForget(sym_environment *env)
+{
+	int iter;
+	for(iter=0;iter<MODEL_CACHE_SIZE;iter++)
+		if(modelCache[iter].env==env)
+			modelCache[iter].env=NULL;
+}
+
+static bool isCached(sym_environment *env)
+{
+	int iter;
+	for(iter=0;iter<MODEL_CACHE_SIZE;iter++)
+		if(modelCache[iter].env==env)
+			return true;
+	return false;
+}
+
+//mixes 8 bytes at a time, with the tail and the length mixed in at the end
+static uint64_t hashBytes(uint64_t hash, const void *data, size_t length)
+{
+	const unsigned char *bytes=(const unsigned char*)data;
+	uint64_t word;
+	size_t iter;
+	for(iter=0;iter+8<=length;iter+=8){
+		memcpy(&word,bytes+iter,8);
+		hash^=word*0x9E3779B97F4A7C15ull;
+		hash=(hash<<31 | hash>>33)*0xC2B2AE3D27D4EB4Full;
+	}
+	word=length;
+	for(;iter<length;iter++)
+		word=(word<<8)|bytes[iter];
+	hash^=word*0x9E3779B97F4A7C15ull;
+	hash=(hash<<31 | hash>>33)*0xC2B2AE3D27D4EB4Full;
+	return hash;
+}
+
+//hashes the problem loaded in env, so that a cached environment changed since it was stored can be told apart
+//returns 1 if the problem cannot be read
+static int problemDigest(sym_environment *env, uint64_t *digest)
+{
+	int numCols,numRows,numElements,sense,iter,ok;
+	uint64_t hash=0x84222325CBF29CE4ull;
+	char isInt;
+	if(sym_get_num_cols(env,&numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(env,&numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_sense(env,&sense)==FUNCTION_TERMINATED_ABNORMALLY)
+		return 1;
+	hash=hashBytes(hashBytes(hashBytes(hash,&numCols,sizeof(int)),&numRows,sizeof(int)),&sense,sizeof(int));
+	double *colValues=new double[3*numCols+2*numRows+numElements+1];
+	double *rowValues=colValues+3*numCols,*matVal=rowValues+2*numRows;
+	int *matBeg=new int[numCols+1+numElements+1],*matInd=matBeg+numCols+1;
+	char *integers=new char[numCols+1];
+	ok=sym_get_obj_coeff(env,colValues)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_col_lower(env,colValues+numCols)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_col_upper(env,colValues+2*numCols)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_row_lower(env,rowValues)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_row_upper(env,rowValues+numRows)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_matrix(env,&numElements,matBeg,matInd,matVal)!=FUNCTION_TERMINATED_ABNORMALLY;
+	for(iter=0;ok && iter<numCols;iter++){
+		ok=sym_is_integer(env,iter,&isInt)!=FUNCTION_TERMINATED_ABNORMALLY;
+		integers[iter]=isInt;
+	}
+	if(ok){
+		hash=hashBytes(hash,colValues,(size_t)(3*numCols+2*numRows+numElements)*sizeof(double));
+		hash=hashBytes(hash,matBeg,(size_t)(numCols+1+numElements)*sizeof(int));
+		*digest=hashBytes(hash,integers,(size_t)numCols);
+	}
+	delete[] colValues;
+	delete[] matBeg;
+	delete[] integers;
+	return !ok;
+}
+
+static int getFingerprintArgument(int *address, uint64_t *fingerprint)
+{
+	//parse the fingerprint from its hexadecimal string
+	char *text=NULL,*end;
+	if(!isStringType(pvApiCtx,address) || getAllocatedSingleString(pvApiCtx,address,&text)){
+		Scierror(999, "Wrong type for input argument #1: A fingerprint is expected.\n");
+		return 1;
+	}
+	*fingerprint=strtoull(text,&end,16);
+	if(*end!='\0' || end==text){
+		freeAllocatedSingleString(text);
+		Scierror(999, "Wrong value for input argument #1: A fingerprint is expected.\n");
+		return 1;
+	}
+	freeAllocatedSingleString(text);
+	return 0;
+}
+
+int sci_sym_getFingerprint(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress,iter,type,rows,cols,numItems,*itemsInRow,*colPos,*boolValues;
+	double *values;
+	uint64_t hash=0x84222325CBF29CE4ull;
+	char text[17];
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,20) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//each argument is hashed with its type and size, so that [1 2] and [1;2] differ
+	for(iter=1;iter<=nbInputArgument(pvApiCtx);iter++){
+		sciErr = getVarAddressFromPosition(pvApiCtx, iter, &varAddress);
+		if (!sciErr.iErr)
+			sciErr = getVarType(pvApiCtx, varAddress, &type);
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			return 1;
+		}
+		if(type==sci_matrix && !isVarComplex(pvApiCtx,varAddress)){
+			sciErr=getMatrixOfDouble(pvApiCtx,varAddress,&rows,&cols,&values);
+			if(!sciErr.iErr)
+				hash=hashBytes(hashBytes(hash,&type,sizeof(int)),values,(size_t)rows*cols*sizeof(double));
+		}else if(type==sci_sparse && !isVarComplex(pvApiCtx,varAddress)){
+			sciErr=getSparseMatrix(pvApiCtx,varAddress,&rows,&cols,&numItems,&itemsInRow,&colPos,&values);
+			if(!sciErr.iErr){
+				hash=hashBytes(hashBytes(hash,&type,sizeof(int)),itemsInRow,(size_t)rows*sizeof(int));
+				hash=hashBytes(hashBytes(hash,colPos,(size_t)numItems*sizeof(int)),values,(size_t)numItems*sizeof(double));
+			}
+		}else if(type==sci_boolean){
+			sciErr=getMatrixOfBoolean(pvApiCtx,varAddress,&rows,&cols,&boolValues);
+			if(!sciErr.iErr)
+				hash=hashBytes(hashBytes(hash,&type,sizeof(int)),boolValues,(size_t)rows*cols*sizeof(int));
+		}else{
+			Scierror(999, "Wrong type for input argument #%d: A real, sparse or boolean matrix is expected.\n",iter);
+			return 1;
+		}
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			return 1;
+		}
+		hash=hashBytes(hashBytes(hash,&rows,sizeof(int)),&cols,sizeof(int));
+	}
+
+	//code to give output: 64 bits do not fit in a double, so a hexadecimal string is returned
+	snprintf(text,sizeof(text),"%016llx",(unsigned long long)hash);
+	if(createSingleString(pvApiCtx,nbInputArgument(pvApiCtx)+1,text))
+		return 1;
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	return 0;
+}
+
+int sci_sym_cacheAcquire(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress,iter,found=-1;
+	uint64_t fingerprint;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: fingerprint of the problem
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(getFingerprintArgument(varAddress,&fingerprint))
+		return 1;
+
+	//an environment the user opened is left open and current: the problem is loaded in it, as without the cache
+	//a cached one is detached, unless its problem has been changed since, in which case the cache drops it
+	if(global_sym_env!=NULL && isCached(global_sym_env)){
+		uint64_t digest;
+		for(iter=0;iter<MODEL_CACHE_SIZE;iter++)
+			if(modelCache[iter].env==global_sym_env)
+				found=iter;
+		if(problemDigest(global_sym_env,&digest) || digest!=modelCache[found].digest)
+			modelCache[found].env=NULL;
+		else
+			global_sym_env=NULL;
+		found=-1;
+	}
+
+	if(global_sym_env==NULL)
+		for(iter=0;iter<MODEL_CACHE_SIZE;iter++)
+			if(modelCache[iter].env!=NULL && modelCache[iter].fingerprint==fingerprint)
+				found=iter;
+	if(found>=0){
+		//same problem: only the parameters, priorities and lazy constraints are reset
+		global_sym_env=modelCache[found].env;
+		modelCache[found].lastUse=++modelCacheClock;
+		sym_set_defaults(global_sym_env);
+		threadsSetDefault(global_sym_env);
+		branchingForget(global_sym_env);
+		lazyForget(global_sym_env);
+	}
+
+	//code to give output
+	if(createScalarBoolean(pvApiCtx,nbInputArgument(pvApiCtx)+1,found>=0))
+		return 1;
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	return 0;
+}
+
+int sci_sym_cacheStore(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress,iter,slot=0;
+	uint64_t fingerprint,digest;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: fingerprint of the loaded problem
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if(getFingerprintArgument(varAddress,&fingerprint))
+		return 1;
+	if(problemDigest(global_sym_env,&digest)){
+		Scierror(999, "The loaded problem could not be read.\n");
+		return 1;
+	}
+
+	//use the entry of this environment, else the entry of the same problem, else a free one, else the least recently used one
+	modelCacheForget(global_sym_env);
+	for(iter=0;iter<MODEL_CACHE_SIZE;iter++)
+		if(modelCache[iter].env!=NULL && modelCache[iter].fingerprint==fingerprint)
+			break;
+	if(iter<MODEL_CACHE_SIZE)
+		slot=iter;
+	else for(iter=0;iter<MODEL_CACHE_SIZE;iter++){
+		if(modelCache[iter].env==NULL){
+			slot=iter;
+			break;
+		}
+		if(modelCache[iter].lastUse<modelCache[slot].lastUse)
+			slot=iter;
+	}
+	if(modelCache[slot].env!=NULL){
+		sym_environment *evicted=modelCache[slot].env;
+		forgetEnvironment(evicted);
+		sym_close_environment(evicted);
+	}
+	modelCache[slot].env=global_sym_env;
+	modelCache[slot].fingerprint=fingerprint;
+	modelCache[slot].digest=digest;
+	modelCache[slot].lastUse=++modelCacheClock;
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_cacheRelease(char *fname){
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//the cache keeps the environment, so later changes through the other functions cannot alter a cached problem
+	if(global_sym_env!=NULL && isCached(global_sym_env))
+		global_sym_env=NULL;
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_cacheClear(char *fname){
+
+	//data declarations
+	int iter;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	for(iter=0;iter<MODEL_CACHE_SIZE;iter++)
+		if(modelCache[iter].env!=NULL){
+			sym_environment *cached=modelCache[iter].env;
+			if(cached==global_sym_env)
+				global_sym_env=NULL;
+			forgetEnvironment(cached);
+			sym_close_environment(cached);
+		}
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+}
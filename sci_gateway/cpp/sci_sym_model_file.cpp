@@ -0,0 +1,233 @@
+/*
+ * Symphony Toolbox
+ * Functions for saving the loaded problem to a binary file and loading it back
+ * The file is memory mapped when loaded and its arrays are given to sym_explicit_load_problem as they are
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_model_file.hpp"
+#include "sci_sym_presolve.hpp"
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vector>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+#include <string.h>
+
+//get the name of the file from input 1, to be freed with freeAllocatedSingleString
+static int getModelFileName(char **fileName)
+{
+	SciErr sciErr;
+	int *varAddress;
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A file name is expected.\n");
+		return 1;
+	}
+	return 0;
+}
+
+//write count bytes of data at offset, padding the file with zeros up to it
+static bool writeModelArray(FILE *file, size_t *position, size_t offset, const void *data, size_t count)
+{
+	static const char zeros[8]={0};
+	if(offset>*position && fwrite(zeros,1,offset-*position,file)!=offset-*position)
+		return false;
+	if(count && fwrite(data,1,count,file)!=count)
+		return false;
+	*position=offset+count;
+	return true;
+}
+
+int sci_sym_saveModel(char *fname){
+
+	//data declarations
+	char *fileName=NULL;
+	int iter,numElements;
+	char isInt;
+	modelFileHeader header;
+	modelFileLayout layout;
+	FILE *file;
+	size_t position=0;
+	bool written;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	memset(&header,0,sizeof(header));
+	memcpy(header.magic,MODEL_FILE_MAGIC,sizeof(header.magic));
+	header.version=MODEL_FILE_VERSION;
+	header.byteOrder=MODEL_FILE_BYTE_ORDER;
+	if(sym_get_num_cols(global_sym_env,&header.numCols)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_rows(global_sym_env,&header.numRows)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(global_sym_env,&numElements)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_sense(global_sym_env,&header.objSense)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "No problem is loaded. Please load a problem first.\n");
+		return 1;
+	}
+	header.numElements=numElements;
+
+	//get the whole problem from symphony, in the form sym_explicit_load_problem takes it
+	std::vector<int> colStart(header.numCols+1),rowIndex(numElements+1);
+	std::vector<double> value(numElements+1),lower(header.numCols+1),upper(header.numCols+1),objective(header.numCols+1);
+	std::vector<double> rowRHS(header.numRows+1),rowRange(header.numRows+1);
+	std::vector<char> rowSense(header.numRows+1),integrality(header.numCols+1);
+	if(sym_get_matrix(global_sym_env,&numElements,&colStart[0],&rowIndex[0],&value[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_lower(global_sym_env,&lower[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_col_upper(global_sym_env,&upper[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_coeff(global_sym_env,&objective[0])==FUNCTION_TERMINATED_ABNORMALLY ||
+		(header.numRows && sym_get_row_sense(global_sym_env,&rowSense[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(header.numRows && sym_get_rhs(global_sym_env,&rowRHS[0])==FUNCTION_TERMINATED_ABNORMALLY) ||
+		(header.numRows && sym_get_row_range(global_sym_env,&rowRange[0])==FUNCTION_TERMINATED_ABNORMALLY)){
+		Scierror(999, "An error occured while getting the problem from Symphony.\n");
+		return 1;
+	}
+	//symphony gives the objective of a maximization negated, the file holds it as it was given
+	for(iter=0;iter<header.numCols;iter++){
+		sym_is_integer(global_sym_env,iter,&isInt);
+		integrality[iter]=isInt?TRUE:FALSE;
+		objective[iter]*=header.objSense;
+	}
+	modelFileGetLayout(&header,&layout);
+
+	//get input 1: name of the file to write
+	if(getModelFileName(&fileName))
+		return 1;
+	file=fopen(fileName,"wb");
+	if(file==NULL){
+		Scierror(999, "Unable to write file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	written=writeModelArray(file,&position,0,&header,sizeof(header)) &&
+		writeModelArray(file,&position,layout.colStart,&colStart[0],(header.numCols+1)*sizeof(int)) &&
+		writeModelArray(file,&position,layout.rowIndex,&rowIndex[0],numElements*sizeof(int)) &&
+		writeModelArray(file,&position,layout.value,&value[0],numElements*sizeof(double)) &&
+		writeModelArray(file,&position,layout.lower,&lower[0],header.numCols*sizeof(double)) &&
+		writeModelArray(file,&position,layout.upper,&upper[0],header.numCols*sizeof(double)) &&
+		writeModelArray(file,&position,layout.objective,&objective[0],header.numCols*sizeof(double)) &&
+		writeModelArray(file,&position,layout.rowRHS,&rowRHS[0],header.numRows*sizeof(double)) &&
+		writeModelArray(file,&position,layout.rowRange,&rowRange[0],header.numRows*sizeof(double)) &&
+		writeModelArray(file,&position,layout.isInt,&integrality[0],header.numCols) &&
+		writeModelArray(file,&position,layout.rowSense,&rowSense[0],header.numRows) &&
+		writeModelArray(file,&position,layout.size,NULL,0);
+	if(fclose(file) || !written){
+		Scierror(999, "Unable to write file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	freeAllocatedSingleString(fileName);
+	sciprint("Problem saved: %d constraints, %d variables, %d nonzeros.\n",header.numRows,header.numCols,numElements);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_loadModel(char *fname){
+
+	//data declarations
+	char *fileName=NULL,*data;
+	const char *error=NULL;
+	int fd;
+	struct stat info;
+	modelFileHeader *header;
+	modelFileLayout layout;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: name of the file to read
+	if(getModelFileName(&fileName))
+		return 1;
+	fd=open(fileName,O_RDONLY);
+	if(fd<0 || fstat(fd,&info)<0){
+		if(fd>=0) close(fd);
+		Scierror(999, "Unable to read file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	freeAllocatedSingleString(fileName);
+	if((size_t)info.st_size<sizeof(modelFileHeader)){
+		close(fd);
+		Scierror(999, "The file is not a model file.\n");
+		return 1;
+	}
+
+	//a private writable mapping, in case symphony writes to the arrays it is given
+	data=(char*)mmap(NULL,info.st_size,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+	close(fd);
+	if(data==MAP_FAILED){
+		Scierror(999, "Unable to map the file into memory.\n");
+		return 1;
+	}
+	header=(modelFileHeader*)data;
+	if(memcmp(header->magic,MODEL_FILE_MAGIC,sizeof(header->magic)))
+		error="The file is not a model file.";
+	else if(header->byteOrder!=MODEL_FILE_BYTE_ORDER)
+		error="The file was written on a machine with a different byte order.";
+	else if(header->version!=MODEL_FILE_VERSION)
+		error="The file was written by a different version of the toolbox.";
+	else if(header->numCols<0 || header->numRows<0 || header->numElements<0)
+		error="The file is corrupted.";
+	else{
+		modelFileGetLayout(header,&layout);
+		if(layout.size>(size_t)info.st_size || ((int*)(data+layout.colStart))[header->numCols]!=header->numElements)
+			error="The file is truncated or corrupted.";
+	}
+	if(error){
+		munmap(data,info.st_size);
+		Scierror(999, "%s\n",error);
+		return 1;
+	}
+
+	presolveLoadProblem(global_sym_env,header->numCols,header->numRows,(int*)(data+layout.colStart),
+		(int*)(data+layout.rowIndex),(double*)(data+layout.value),(double*)(data+layout.lower),(double*)(data+layout.upper),
+		data+layout.isInt,(double*)(data+layout.objective),data+layout.rowSense,(double*)(data+layout.rowRHS),
+		(double*)(data+layout.rowRange),header->objSense);
+	sym_set_obj_sense(global_sym_env,header->objSense);
+	sciprint("Problem loaded: %d constraints, %d variables, %d nonzeros.\n",header->numRows,header->numCols,header->numElements);
+	munmap(data,info.st_size);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+}
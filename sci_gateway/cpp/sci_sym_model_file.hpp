@@ -0,0 +1,57 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) The binary model file written by sym_saveModel and read by sym_loadModel
+// The file is a header followed by the arrays of the problem, each starting at a multiple of 8 bytes,
+// so that the arrays can be used in place once the file is memory mapped
+
+#ifndef SCI_SYMMODELFILEHEADER
+#define SCI_SYMMODELFILEHEADER
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MODEL_FILE_MAGIC "SYMMODEL"
+#define MODEL_FILE_VERSION 1
+#define MODEL_FILE_BYTE_ORDER 0x01020304	//read back differently on a machine with another byte order
+
+struct modelFileHeader{
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	int32_t numCols,numRows,numElements;
+	int32_t objSense;	//1 for minimization, -1 for maximization
+};
+
+//position of the arrays in the file, in bytes from its start
+struct modelFileLayout{
+	size_t colStart;	//int32[numCols+1]
+	size_t rowIndex;	//int32[numElements]
+	size_t value;		//double[numElements]
+	size_t lower,upper,objective;	//double[numCols]
+	size_t rowRHS,rowRange;	//double[numRows]
+	size_t isInt;		//char[numCols]
+	size_t rowSense;	//char[numRows]
+	size_t size;		//total size of the file
+};
+
+static inline size_t modelFileAlign(size_t offset)
+{
+	return (offset+7)&~(size_t)7;
+}
+
+static inline void modelFileGetLayout(const modelFileHeader *header, modelFileLayout *layout)
+{
+	size_t numCols=header->numCols,numRows=header->numRows,numElements=header->numElements;
+	layout->colStart=modelFileAlign(sizeof(modelFileHeader));
+	layout->rowIndex=modelFileAlign(layout->colStart+(numCols+1)*sizeof(int32_t));
+	layout->value=modelFileAlign(layout->rowIndex+numElements*sizeof(int32_t));
+	layout->lower=layout->value+numElements*sizeof(double);
+	layout->upper=layout->lower+numCols*sizeof(double);
+	layout->objective=layout->upper+numCols*sizeof(double);
+	layout->rowRHS=layout->objective+numCols*sizeof(double);
+	layout->rowRange=layout->rowRHS+numRows*sizeof(double);
+	layout->isInt=layout->rowRange+numRows*sizeof(double);
+	layout->rowSense=layout->isInt+numCols;
+	layout->size=modelFileAlign(layout->rowSense+numRows);
+}
+
+#endif //SCI_SYMMODELFILEHEADER
@@ -0,0 +1,701 @@
+/*
+ * Symphony Toolbox
+ * Fast reader for free format MPS files, plain or compressed with gzip
+ * Plain files are memory mapped, compressed ones are inflated into memory. The COLUMNS section
+ * is tokenized by several threads and the problem is built in column-major form and loaded
+ * with sym_explicit_load_problem
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
+#include <vector>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#define MPS_MAX_TOKENS 8
+#define MPS_OBJECTIVE_ROW -1
+#define MPS_FREE_ROW -2 //rows of type N other than the objective are dropped
+
+//a name or number in the file, not null-terminated
+struct mpsToken{
+	const char *ptr;
+	int len;
+};
+
+static bool sameToken(const mpsToken &a, const mpsToken &b)
+{
+	return a.len==b.len && memcmp(a.ptr,b.ptr,a.len)==0;
+}
+
+static bool tokenIs(const mpsToken &tok, const char *word)
+{
+	return (int)strlen(word)==tok.len && memcmp(tok.ptr,word,tok.len)==0;
+}
+
+//split the line starting at pos into tokens, returns the start of the next line
+static const char *splitLine(const char *pos, const char *end, mpsToken *tokens, int *numTokens)
+{
+	const char *lineEnd=(const char*)memchr(pos,'\n',end-pos);
+	if(lineEnd==NULL)
+		lineEnd=end;
+	*numTokens=0;
+	while(pos<lineEnd){
+		while(pos<lineEnd && (*pos==' ' || *pos=='\t' || *pos=='\r'))
+			pos++;
+		if(pos==lineEnd)
+			break;
+		tokens[*numTokens].ptr=pos;
+		while(pos<lineEnd && *pos!=' ' && *pos!='\t' && *pos!='\r')
+			pos++;
+		tokens[*numTokens].len=pos-tokens[*numTokens].ptr;
+		if(*numTokens<MPS_MAX_TOKENS)
+			(*numTokens)++;
+	}
+	return lineEnd<end?lineEnd+1:end;
+}
+
+static bool parseNumber(const mpsToken &tok, double *value)
+{
+	char buffer[64],*end;
+	if(tok.len>=(int)sizeof(buffer))
+		return false;
+	memcpy(buffer,tok.ptr,tok.len);
+	buffer[tok.len]='\0';
+	*value=strtod(buffer,&end);
+	return end==buffer+tok.len;
+}
+
+//hash table from names to indices, filled once and then only read, so it can be shared by threads
+class mpsNameTable{
+public:
+	std::vector<mpsToken> names;
+	std::vector<int> values;
+	std::vector<int> slots;
+
+	void build(){
+		unsigned size=16,iter;
+		while(size<2*names.size())
+			size*=2;
+		slots.assign(size,-1);
+		for(iter=0;iter<names.size();iter++){
+			unsigned slot=hash(names[iter])&(size-1);
+			while(slots[slot]!=-1)
+				slot=(slot+1)&(size-1);
+			slots[slot]=iter;
+		}
+	}
+	//returns the position of the name in names, or -1
+	int find(const mpsToken &tok) const{
+		unsigned mask=slots.size()-1,slot=hash(tok)&mask;
+		while(slots[slot]!=-1){
+			if(sameToken(names[slots[slot]],tok))
+				return slots[slot];
+			slot=(slot+1)&mask;
+		}
+		return -1;
+	}
+private:
+	static unsigned hash(const mpsToken &tok){
+		unsigned value=2166136261u;
+		int iter;
+		for(iter=0;iter<tok.len;iter++)
+			value=(value^(unsigned char)tok.ptr[iter])*16777619u;
+		return value;
+	}
+};
+
+//part of the COLUMNS section read by one thread
+struct mpsColumnRun{
+	mpsToken name;
+	int firstEntry,numEntries;
+	int marker; //0 for a column, 1 for an INTORG marker, 2 for an INTEND marker
+};
+struct mpsColumnChunk{
+	const char *begin,*end;
+	const mpsNameTable *rows;
+	std::vector<mpsColumnRun> runs;
+	std::vector<int> entryRow;
+	std::vector<double> entryValue;
+	char error[160];
+};
+
+static void *readColumnChunk(void *arg)
+{
+	mpsColumnChunk *chunk=(mpsColumnChunk*)arg;
+	mpsToken tokens[MPS_MAX_TOKENS];
+	int numTokens,iter,row;
+	double value;
+	const char *pos=chunk->begin;
+	chunk->error[0]='\0';
+	while(pos<chunk->end){
+		pos=splitLine(pos,chunk->end,tokens,&numTokens);
+		if(numTokens==0 || tokens[0].ptr[0]=='*')
+			continue;
+		if(numTokens>=3 && tokenIs(tokens[1],"'MARKER'")){
+			mpsColumnRun run={tokens[0],0,0,0};
+			if(tokenIs(tokens[2],"'INTORG'"))
+				run.marker=1;
+			else if(tokenIs(tokens[2],"'INTEND'"))
+				run.marker=2;
+			else{
+				snprintf(chunk->error,sizeof(chunk->error),"Unknown marker %.*s in COLUMNS section.",tokens[2].len,tokens[2].ptr);
+				return NULL;
+			}
+			chunk->runs.push_back(run);
+			continue;
+		}
+		if(numTokens!=3 && numTokens!=5){
+			snprintf(chunk->error,sizeof(chunk->error),"Wrong number of fields for column %.*s in COLUMNS section.",tokens[0].len,tokens[0].ptr);
+			return NULL;
+		}
+		if(chunk->runs.empty() || chunk->runs.back().marker!=0 || !sameToken(chunk->runs.back().name,tokens[0])){
+			mpsColumnRun run={tokens[0],(int)chunk->entryRow.size(),0,0};
+			chunk->runs.push_back(run);
+		}
+		for(iter=1;iter<numTokens;iter+=2){
+			row=chunk->rows->find(tokens[iter]);
+			if(row<0){
+				snprintf(chunk->error,sizeof(chunk->error),"Unknown row %.*s in COLUMNS section.",tokens[iter].len,tokens[iter].ptr);
+				return NULL;
+			}
+			if(!parseNumber(tokens[iter+1],&value)){
+				snprintf(chunk->error,sizeof(chunk->error),"Wrong value %.*s in COLUMNS section.",tokens[iter+1].len,tokens[iter+1].ptr);
+				return NULL;
+			}
+			row=chunk->rows->values[row];
+			if(row==MPS_FREE_ROW)
+				continue;
+			chunk->entryRow.push_back(row);
+			chunk->entryValue.push_back(value);
+			chunk->runs.back().numEntries++;
+		}
+	}
+	return NULL;
+}
+
+//the whole file in memory, either mapped or inflated
+struct mpsFile{
+	const char *data;
+	size_t size;
+	bool mapped;
+};
+
+static bool openMPSFile(const char *fileName, mpsFile *file)
+{
+	size_t nameLength=strlen(fileName);
+	file->data=NULL;
+	file->size=0;
+	if(nameLength>3 && strcmp(fileName+nameLength-3,".gz")==0){
+		//inflate the whole file, growing the buffer as needed
+		gzFile input=gzopen(fileName,"rb");
+		size_t capacity=1<<24;
+		char *buffer,*larger;
+		int count;
+		if(input==NULL)
+			return false;
+		gzbuffer(input,1<<20);
+		buffer=(char*)malloc(capacity);
+		while(buffer!=NULL && (count=gzread(input,buffer+file->size,capacity-file->size))>0){
+			file->size+=count;
+			if(file->size==capacity){
+				capacity*=2;
+				larger=(char*)realloc(buffer,capacity);
+				if(larger==NULL)
+					free(buffer);
+				buffer=larger;
+			}
+		}
+		gzclose(input);
+		if(buffer==NULL || count<0){
+			if(buffer) free(buffer);
+			return false;
+		}
+		file->data=buffer;
+		file->mapped=false;
+		return true;
+	}
+	int fd=open(fileName,O_RDONLY);
+	struct stat info;
+	if(fd<0)
+		return false;
+	if(fstat(fd,&info)<0 || info.st_size==0){
+		close(fd);
+		return false;
+	}
+	void *map=mmap(NULL,info.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+	close(fd);
+	if(map==MAP_FAILED)
+		return false;
+	madvise(map,info.st_size,MADV_SEQUENTIAL);
+	file->data=(const char*)map;
+	file->size=info.st_size;
+	file->mapped=true;
+	return true;
+}
+
+static void closeMPSFile(mpsFile *file)
+{
+	if(file->data==NULL)
+		return;
+	if(file->mapped)
+		munmap((void*)file->data,file->size);
+	else
+		free((void*)file->data);
+	file->data=NULL;
+}
+
+//the problem as it is read, before it is given to symphony
+struct mpsProblem{
+	int numRows,numCols;
+	std::vector<char> rowType;
+	std::vector<double> rhs,range;
+	std::vector<int> colStart,rowIndex;
+	std::vector<double> value,objective,lower,upper;
+	std::vector<char> isInt;
+	std::vector<mpsToken> colNames;
+	bool maximize;
+};
+
+static int readMPS(const mpsFile *file, int numThreads, mpsProblem *prob, char *error, size_t errorSize)
+{
+	const char *pos=file->data,*end=file->data+file->size,*lineStart;
+	const char *columnsBegin=NULL,*columnsEnd=NULL;
+	mpsToken tokens[MPS_MAX_TOKENS];
+	int numTokens,iter,index,section=0; //0 none, 1 ROWS, 2 COLUMNS, 3 RHS, 4 RANGES, 5 BOUNDS, 6 OBJSENSE
+	bool haveObjective=false;
+	double value;
+	mpsNameTable rows,cols;
+	std::vector<mpsToken> rhsLines,rangeLines,boundLines; //first token of each line, parsed once all names are known
+	std::vector<const char*> rhsPos,rangePos,boundPos;
+
+	prob->numRows=0;
+	prob->maximize=false;
+
+	//one pass over the section headers, reading the ROWS section and remembering where the others are
+	while(pos<end){
+		lineStart=pos;
+		pos=splitLine(pos,end,tokens,&numTokens);
+		if(numTokens==0 || tokens[0].ptr[0]=='*')
+			continue;
+		if(tokens[0].ptr==lineStart){
+			//a section header starts in the first column
+			if(section==2)
+				columnsEnd=lineStart;
+			if(tokenIs(tokens[0],"NAME"))
+				section=0;
+			else if(tokenIs(tokens[0],"ROWS"))
+				section=1;
+			else if(tokenIs(tokens[0],"COLUMNS")){
+				section=2;
+				columnsBegin=pos;
+				columnsEnd=end;
+				//skip the section here, it is read by the threads
+				while(pos<end){
+					const char *next=(const char*)memchr(pos,'\n',end-pos);
+					if(*pos!=' ' && *pos!='\t' && *pos!='*' && *pos!='\n' && *pos!='\r')
+						break;
+					pos=next?next+1:end;
+				}
+			}
+			else if(tokenIs(tokens[0],"RHS"))
+				section=3;
+			else if(tokenIs(tokens[0],"RANGES"))
+				section=4;
+			else if(tokenIs(tokens[0],"BOUNDS"))
+				section=5;
+			else if(tokenIs(tokens[0],"OBJSENSE")){
+				section=6;
+				if(numTokens>1)
+					prob->maximize=tokenIs(tokens[1],"MAX") || tokenIs(tokens[1],"MAXIMIZE");
+			}
+			else if(tokenIs(tokens[0],"ENDATA"))
+				break;
+			else{
+				snprintf(error,errorSize,"Section %.*s is not supported.",tokens[0].len,tokens[0].ptr);
+				return 1;
+			}
+			continue;
+		}
+		switch(section){
+			case 1:
+				if(numTokens!=2 || tokens[0].len!=1){
+					snprintf(error,errorSize,"Wrong line in ROWS section.");
+					return 1;
+				}
+				rows.names.push_back(tokens[1]);
+				switch(tokens[0].ptr[0]){
+					case 'N':case 'n':
+						rows.values.push_back(haveObjective?MPS_FREE_ROW:MPS_OBJECTIVE_ROW);
+						haveObjective=true;
+						break;
+					case 'L':case 'l':case 'G':case 'g':case 'E':case 'e':
+						rows.values.push_back(prob->numRows++);
+						prob->rowType.push_back(toupper(tokens[0].ptr[0]));
+						break;
+					default:
+						snprintf(error,errorSize,"Unknown row type %c in ROWS section.",tokens[0].ptr[0]);
+						return 1;
+				}
+				break;
+			case 3:
+				rhsPos.push_back(lineStart);
+				break;
+			case 4:
+				rangePos.push_back(lineStart);
+				break;
+			case 5:
+				boundPos.push_back(lineStart);
+				break;
+			case 6:
+				prob->maximize=tokenIs(tokens[0],"MAX") || tokenIs(tokens[0],"MAXIMIZE");
+				break;
+			default:
+				snprintf(error,errorSize,"Data outside of a section.");
+				return 1;
+		}
+	}
+	if(columnsBegin==NULL){
+		snprintf(error,errorSize,"The COLUMNS section is missing.");
+		return 1;
+	}
+	rows.build();
+	//a repeated name would send all the entries of both rows to one of them, so every name is looked up
+	for(iter=0;iter<(int)rows.names.size();iter++)
+		if(rows.find(rows.names[iter])!=iter){
+			snprintf(error,errorSize,"Row %.*s is declared twice.",rows.names[iter].len,rows.names[iter].ptr);
+			return 1;
+		}
+
+	//COLUMNS: split into chunks at line boundaries, one per thread
+	size_t columnsSize=columnsEnd-columnsBegin;
+	if(columnsSize<(1<<20))
+		numThreads=1; //not worth starting threads for
+	std::vector<mpsColumnChunk> chunks(numThreads);
+	std::vector<pthread_t> threads(numThreads);
+	const char *chunkBegin=columnsBegin;
+	for(iter=0;iter<numThreads;iter++){
+		const char *chunkEnd=(iter==numThreads-1)?columnsEnd:columnsBegin+columnsSize*(iter+1)/numThreads;
+		if(chunkEnd<chunkBegin)
+			chunkEnd=chunkBegin;
+		if(iter<numThreads-1 && chunkEnd<columnsEnd){
+			const char *newline=(const char*)memchr(chunkEnd,'\n',columnsEnd-chunkEnd);
+			chunkEnd=newline?newline+1:columnsEnd;
+		}
+		chunks[iter].begin=chunkBegin;
+		chunks[iter].end=chunkEnd;
+		chunks[iter].rows=&rows;
+		chunkBegin=chunkEnd;
+	}
+	for(iter=1;iter<numThreads;iter++)
+		if(pthread_create(&threads[iter],NULL,readColumnChunk,&chunks[iter])){
+			readColumnChunk(&chunks[iter]);
+			threads[iter]=pthread_self();
+		}
+	readColumnChunk(&chunks[0]);
+	for(iter=1;iter<numThreads;iter++)
+		if(!pthread_equal(threads[iter],pthread_self()))
+			pthread_join(threads[iter],NULL);
+	for(iter=0;iter<numThreads;iter++)
+		if(chunks[iter].error[0]){
+			snprintf(error,errorSize,"%s",chunks[iter].error);
+			return 1;
+		}
+
+	//join the runs into columns, a column may continue from one chunk into the next
+	int chunkIter,runIter,entryIter,numEntries=0;
+	bool inIntegerBlock=false;
+	std::vector<int> columnOfRun;
+	prob->numCols=0;
+	prob->colStart.push_back(0);
+	for(chunkIter=0;chunkIter<numThreads;chunkIter++)
+		for(runIter=0;runIter<(int)chunks[chunkIter].runs.size();runIter++){
+			mpsColumnRun &run=chunks[chunkIter].runs[runIter];
+			if(run.marker){
+				inIntegerBlock=(run.marker==1);
+				continue;
+			}
+			if(prob->numCols==0 || !sameToken(prob->colNames.back(),run.name) || columnOfRun.empty()){
+				prob->colNames.push_back(run.name);
+				prob->isInt.push_back(inIntegerBlock?TRUE:FALSE);
+				prob->objective.push_back(0);
+				prob->colStart.push_back(prob->colStart.back());
+				prob->numCols++;
+			}
+			columnOfRun.push_back(prob->numCols-1);
+			for(entryIter=0;entryIter<run.numEntries;entryIter++)
+				if(chunks[chunkIter].entryRow[run.firstEntry+entryIter]!=MPS_OBJECTIVE_ROW)
+					prob->colStart.back()++;
+		}
+	if(prob->numCols==0){
+		snprintf(error,errorSize,"The COLUMNS section has no variables.");
+		return 1;
+	}
+	numEntries=prob->colStart.back();
+	prob->rowIndex.resize(numEntries);
+	prob->value.resize(numEntries);
+	int runNumber=0,column,next;
+	for(chunkIter=0;chunkIter<numThreads;chunkIter++)
+		for(runIter=0;runIter<(int)chunks[chunkIter].runs.size();runIter++){
+			mpsColumnRun &run=chunks[chunkIter].runs[runIter];
+			if(run.marker)
+				continue;
+			column=columnOfRun[runNumber++];
+			//colStart[column+1] already counts this column, fill from the current position
+			for(entryIter=0;entryIter<run.numEntries;entryIter++){
+				int row=chunks[chunkIter].entryRow[run.firstEntry+entryIter];
+				value=chunks[chunkIter].entryValue[run.firstEntry+entryIter];
+				if(row==MPS_OBJECTIVE_ROW)
+					prob->objective[column]=value;
+				else{
+					next=prob->colStart[column]++;
+					prob->rowIndex[next]=row;
+					prob->value[next]=value;
+				}
+			}
+		}
+	//colStart[column] has been moved to the start of the next column, shift it back
+	for(column=prob->numCols;column>0;column--)
+		prob->colStart[column]=prob->colStart[column-1];
+	prob->colStart[0]=0;
+	chunks.clear();
+
+	cols.names=prob->colNames;
+	cols.build();
+	for(iter=0;iter<prob->numCols;iter++)
+		if(cols.find(prob->colNames[iter])!=iter){
+			snprintf(error,errorSize,"Column %.*s is declared twice.",prob->colNames[iter].len,prob->colNames[iter].ptr);
+			return 1;
+		}
+
+	//RHS and RANGES: [set name] row value [row value]
+	prob->rhs.assign(prob->numRows,0);
+	prob->range.assign(prob->numRows,NAN);
+	for(int pass=0;pass<2;pass++){
+		std::vector<const char*> &lines=(pass==0)?rhsPos:rangePos;
+		std::vector<double> &target=(pass==0)?prob->rhs:prob->range;
+		for(iter=0;iter<(int)lines.size();iter++){
+			splitLine(lines[iter],end,tokens,&numTokens);
+			int first=(numTokens==3 || numTokens==5)?1:0;
+			if(numTokens<2 || numTokens>5){
+				snprintf(error,errorSize,"Wrong number of fields in %s section.",pass==0?"RHS":"RANGES");
+				return 1;
+			}
+			for(int field=first;field+1<numTokens;field+=2){
+				index=rows.find(tokens[field]);
+				if(index<0 || !parseNumber(tokens[field+1],&value)){
+					snprintf(error,errorSize,"Wrong entry %.*s in %s section.",tokens[field].len,tokens[field].ptr,pass==0?"RHS":"RANGES");
+					return 1;
+				}
+				index=rows.values[index];
+				if(index>=0) //the objective constant and free rows are ignored
+					target[index]=value;
+			}
+		}
+	}
+
+	//BOUNDS: type [set name] column [value]
+	prob->lower.assign(prob->numCols,0);
+	prob->upper.assign(prob->numCols,INFINITY);
+	for(iter=0;iter<(int)boundPos.size();iter++){
+		splitLine(boundPos[iter],end,tokens,&numTokens);
+		bool needsValue=!(tokenIs(tokens[0],"FR") || tokenIs(tokens[0],"MI") || tokenIs(tokens[0],"PL") || tokenIs(tokens[0],"BV"));
+		int columnField;
+		if(needsValue)
+			columnField=(numTokens==4)?2:1;
+		else
+			columnField=(numTokens>=3 && cols.find(tokens[1])<0)?2:1;
+		if(columnField>=numTokens || (needsValue && (columnField+1>=numTokens || !parseNumber(tokens[columnField+1],&value)))){
+			snprintf(error,errorSize,"Wrong line in BOUNDS section.");
+			return 1;
+		}
+		index=cols.find(tokens[columnField]);
+		if(index<0){
+			snprintf(error,errorSize,"Unknown column %.*s in BOUNDS section.",tokens[columnField].len,tokens[columnField].ptr);
+			return 1;
+		}
+		if(tokenIs(tokens[0],"UP")){
+			prob->upper[index]=value;
+			if(value<0 && prob->lower[index]==0)
+				prob->lower[index]=-INFINITY;
+		}else if(tokenIs(tokens[0],"LO"))
+			prob->lower[index]=value;
+		else if(tokenIs(tokens[0],"FX"))
+			prob->lower[index]=prob->upper[index]=value;
+		else if(tokenIs(tokens[0],"FR")){
+			prob->lower[index]=-INFINITY;
+			prob->upper[index]=INFINITY;
+		}else if(tokenIs(tokens[0],"MI"))
+			prob->lower[index]=-INFINITY;
+		else if(tokenIs(tokens[0],"PL"))
+			prob->upper[index]=INFINITY;
+		else if(tokenIs(tokens[0],"BV")){
+			prob->isInt[index]=TRUE;
+			prob->lower[index]=0;
+			prob->upper[index]=1;
+		}else if(tokenIs(tokens[0],"LI")){
+			prob->isInt[index]=TRUE;
+			prob->lower[index]=value;
+		}else if(tokenIs(tokens[0],"UI")){
+			prob->isInt[index]=TRUE;
+			prob->upper[index]=value;
+		}else{
+			snprintf(error,errorSize,"Bound type %.*s is not supported.",tokens[0].len,tokens[0].ptr);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+//give the problem to symphony, with constraint types and ranges in its form
+static int loadMPSProblem(mpsProblem *prob)
+{
+	std::vector<char> rowSense(prob->numRows);
+	std::vector<double> rowRHS(prob->numRows),rowRange(prob->numRows,0);
+	std::vector<char*> names(prob->numCols);
+	std::vector<char> nameData;
+	int iter,iRet;
+	double lower,upper,range;
+	for(iter=0;iter<prob->numRows;iter++){
+		range=prob->range[iter];
+		if(isnan(range)){
+			rowSense[iter]=prob->rowType[iter];
+			rowRHS[iter]=prob->rhs[iter];
+			continue;
+		}
+		switch(prob->rowType[iter]){
+			case 'L':
+				lower=prob->rhs[iter]-fabs(range);
+				upper=prob->rhs[iter];
+				break;
+			case 'G':
+				lower=prob->rhs[iter];
+				upper=prob->rhs[iter]+fabs(range);
+				break;
+			default:
+				lower=prob->rhs[iter]+(range<0?range:0);
+				upper=prob->rhs[iter]+(range>0?range:0);
+				break;
+		}
+		rowSense[iter]=(lower==upper)?'E':'R';
+		rowRHS[iter]=upper;
+		rowRange[iter]=upper-lower;
+	}
+	iRet=presolveLoadProblem(global_sym_env,prob->numCols,prob->numRows,&prob->colStart[0],
+		prob->rowIndex.empty()?NULL:&prob->rowIndex[0],prob->value.empty()?NULL:&prob->value[0],
+		&prob->lower[0],&prob->upper[0],&prob->isInt[0],&prob->objective[0],
+		prob->numRows?&rowSense[0]:NULL,prob->numRows?&rowRHS[0]:NULL,prob->numRows?&rowRange[0]:NULL,prob->maximize?-1:1);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY)
+		return 1;
+	sym_set_obj_sense(global_sym_env,prob->maximize?-1:1);
+
+	//a presolved problem has other columns, the names do not apply to it
+	int loadedCols;
+	if(sym_get_num_cols(global_sym_env,&loadedCols)==FUNCTION_TERMINATED_ABNORMALLY || loadedCols!=prob->numCols)
+		return 0;
+
+	//names are kept so that the problem can be written back with them
+	size_t totalLength=0,offset=0;
+	for(iter=0;iter<prob->numCols;iter++)
+		totalLength+=prob->colNames[iter].len+1;
+	nameData.resize(totalLength);
+	for(iter=0;iter<prob->numCols;iter++){
+		names[iter]=&nameData[offset];
+		memcpy(names[iter],prob->colNames[iter].ptr,prob->colNames[iter].len);
+		names[iter][prob->colNames[iter].len]='\0';
+		offset+=prob->colNames[iter].len+1;
+	}
+	sym_set_col_names(global_sym_env,&names[0]);
+	return 0;
+}
+
+int sci_sym_loadMPSFast(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress,numThreads,iRet;
+	char *fileName=NULL,error[200];
+	mpsFile file;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,2) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: name of the file to read
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A file name is expected.\n");
+		return 1;
+	}
+
+	//get input 2: number of threads, by default one per processor
+	numThreads=sysconf(_SC_NPROCESSORS_ONLN);
+	if(nbInputArgument(pvApiCtx)==2 && getUIntFromScilab(2,&numThreads)){
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	if(numThreads<1)
+		numThreads=1;
+
+	if(!openMPSFile(fileName,&file)){
+		Scierror(999, "Unable to read file %s.\n",fileName);
+		freeAllocatedSingleString(fileName);
+		return 1;
+	}
+	freeAllocatedSingleString(fileName);
+
+	{
+		mpsProblem prob;
+		iRet=readMPS(&file,numThreads,&prob,error,sizeof(error));
+		if(!iRet && loadMPSProblem(&prob)){
+			snprintf(error,sizeof(error),"The problem could not be loaded.");
+			iRet=1;
+		}
+		//the names point into the file, so it is closed only once they have been copied
+		closeMPSFile(&file);
+		if(iRet){
+			Scierror(999, "Error while reading file: %s\n",error);
+			return 1;
+		}
+		sciprint("File read successfully: %d constraints, %d variables, %d nonzeros.\n",prob.numRows,prob.numCols,(int)prob.value.size());
+	}
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+}
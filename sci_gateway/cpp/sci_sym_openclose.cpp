@@ -5,6 +5,10 @@
  */
 #include <symphony.h>
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "sci_sym_branching.hpp"
+#include "sci_sym_lazy.hpp"
+#include "sci_sym_timeslice.hpp"
 
 extern sym_environment* global_sym_env;//defined in globals.cpp
 
@@ -15,6 +19,20 @@ extern "C" {
 #include <localization.h>
 #include <sciprint.h>
 
+void modelCacheForget(sym_environment *env); //defined in sci_sym_model_cache.cpp
+void threadsSetDefault(sym_environment *env); //defined in sci_sym_threads.cpp
+
+/* Function that forgets everything the toolbox keeps for an environment,
+ * to be called before it is closed, so that a new environment at the same address starts clean
+ */
+void forgetEnvironment(sym_environment *env){
+	modelCacheForget(env);//a closed environment must not be handed out by the model cache
+	presolveForget(env);
+	branchingForget(env);
+	lazyForget(env);
+	timesliceForget(env);
+}
+
 /* Function that initializes the symphony environment
  * Returns 1 on success , 0 on failure
  */
@@ -37,6 +55,7 @@ int sci_sym_open(char *fname, unsigned long fname_len){
 			sciprint("Error: Unable to create symphony environment.\n");
 		else{
 			status=1;
+			threadsSetDefault(global_sym_env);
 			//sciprint("Symphony environment is created successfully. Please run 'sym_close()' to close.\n");
 			//create useful variables for user
 			createNamedScalarDouble(pvApiCtx,"sym_minimize",1);
@@ -69,6 +88,7 @@ int sci_sym_close(char *fname, unsigned long fname_len){
 	if (global_sym_env==NULL){//check for environment
 		sciprint("Error: symphony environment is not initialized.\n");
 	}else{
+		forgetEnvironment(global_sym_env);
 		output=sym_close_environment(global_sym_env);//close environment
 		if(output==ERROR__USER){	
 			status=0;//User error detected in user_free_master() function or when function invoked unsuccessfully
@@ -0,0 +1,309 @@
+/*
+ * Symphony Toolbox
+ * Presolve of the problem with OsiPresolve before it is loaded, and postsolve of the solution
+ * The original problem is kept in an OsiClp model; the postsolve stack only restates a solution once,
+ * so the problem is presolved again after each postsolve
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "OsiPresolve.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinError.hpp"
+#include <sys/time.h>
+#include <map>
+#include <vector>
+#include <math.h>
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+}
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+#define PRESOLVE_TOLERANCE 1e-8
+#define PRESOLVE_PASSES 5
+
+struct presolveData{
+	OsiClpSolverInterface *original;
+	OsiPresolve *presolve;
+	OsiSolverInterface *reduced;
+	std::vector<double> reducedSolution;	//solution restated last, to know whether it must be done again
+	std::vector<double> colSolution,rowActivity;
+	double objValue;
+	int reducedCols,reducedRows;	//size of the problem given to symphony
+	double removed[3];	//rows, columns and nonzeros removed
+	double presolveTime,postsolveTime;
+};
+
+static std::map<sym_environment*,presolveData*> presolveStates;
+static bool presolveEnabled=false;
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+void presolveForget(sym_environment *env)
+{
+	std::map<sym_environment*,presolveData*>::iterator found=presolveStates.find(env);
+	if(found==presolveStates.end())
+		return;
+	delete found->second->reduced;
+	delete found->second->presolve;
+	delete found->second->original;
+	delete found->second;
+	presolveStates.erase(found);
+}
+
+int presolveCheckIndices(sym_environment *env)
+{
+	if(presolveStates.find(env)==presolveStates.end())
+		return 0;
+	Scierror(999, "The loaded problem is presolved: its variables and constraints are not those of the original problem. Please disable presolve with 'sym_setPresolve(0)' and load the problem again.\n");
+	return 1;
+}
+
+//presolve data->original, returns 0 if it is infeasible or unbounded
+static int runPresolve(presolveData *data)
+{
+	data->presolve=new OsiPresolve();
+	data->reduced=data->presolve->presolvedModel(*data->original,PRESOLVE_TOLERANCE,true,PRESOLVE_PASSES);
+	if(data->reduced==NULL){
+		delete data->presolve;
+		data->presolve=NULL;
+		return 0;
+	}
+	return 1;
+}
+
+int presolveLoadProblem(sym_environment *env, int numCols, int numRows, int *colStart, int *rowIndex,
+	double *value, double *lower, double *upper, char *isInt, double *objective,
+	char *rowSense, double *rowRHS, double *rowRange, int objSense)
+{
+	presolveData *data;
+	double startTime=wallClock(),infinity;
+	int iter,iRet;
+
+	presolveForget(env);
+	if(!presolveEnabled || numCols==0 || numRows==0)
+		return sym_explicit_load_problem(env,numCols,numRows,colStart,rowIndex,value,lower,upper,isInt,
+			objective,NULL,rowSense,rowRHS,rowRange,TRUE);
+
+	data=new presolveData();
+	data->original=new OsiClpSolverInterface();
+	data->original->messageHandler()->setLogLevel(0);
+	data->original->loadProblem(numCols,numRows,colStart,rowIndex,value,lower,upper,objective,rowSense,rowRHS,rowRange);
+	data->original->setObjSense(objSense);
+	for(iter=0;iter<numCols;iter++)
+		if(isInt[iter])
+			data->original->setInteger(iter);
+	if(!runPresolve(data)){
+		sciprint("Presolve found the problem infeasible or unbounded, it is loaded as it is.\n");
+		delete data->original;
+		delete data;
+		return sym_explicit_load_problem(env,numCols,numRows,colStart,rowIndex,value,lower,upper,isInt,
+			objective,NULL,rowSense,rowRHS,rowRange,TRUE);
+	}
+
+	//give the reduced problem to symphony, with its infinite bounds as symphony expects them
+	OsiSolverInterface *reduced=data->reduced;
+	int reducedCols=reduced->getNumCols(),reducedRows=reduced->getNumRows();
+	CoinPackedMatrix matrix(*reduced->getMatrixByCol());
+	matrix.removeGaps();
+	infinity=reduced->getInfinity();
+	std::vector<double> reducedLower(reduced->getColLower(),reduced->getColLower()+reducedCols);
+	std::vector<double> reducedUpper(reduced->getColUpper(),reduced->getColUpper()+reducedCols);
+	std::vector<double> reducedObjective(reduced->getObjCoefficients(),reduced->getObjCoefficients()+reducedCols);
+	std::vector<char> reducedSense(reduced->getRowSense(),reduced->getRowSense()+reducedRows);
+	std::vector<double> reducedRHS(reduced->getRightHandSide(),reduced->getRightHandSide()+reducedRows);
+	std::vector<double> reducedRange(reduced->getRowRange(),reduced->getRowRange()+reducedRows);
+	std::vector<char> reducedIsInt(reducedCols);
+	for(iter=0;iter<reducedCols;iter++){
+		if(reducedLower[iter]<=-infinity)
+			reducedLower[iter]=-INFINITY;
+		if(reducedUpper[iter]>=infinity)
+			reducedUpper[iter]=INFINITY;
+		reducedIsInt[iter]=reduced->isInteger(iter)?TRUE:FALSE;
+	}
+	//symphony does not take empty arrays
+	reducedLower.push_back(0);reducedUpper.push_back(0);reducedObjective.push_back(0);reducedIsInt.push_back(0);
+	reducedSense.push_back('N');reducedRHS.push_back(0);reducedRange.push_back(0);
+	iRet=sym_explicit_load_problem(env,reducedCols,reducedRows,(int*)matrix.getVectorStarts(),(int*)matrix.getIndices(),
+		(double*)matrix.getElements(),&reducedLower[0],&reducedUpper[0],&reducedIsInt[0],&reducedObjective[0],NULL,
+		&reducedSense[0],&reducedRHS[0],&reducedRange[0],TRUE);
+
+	data->reducedCols=reducedCols;
+	data->reducedRows=reducedRows;
+	data->removed[0]=numRows-reducedRows;
+	data->removed[1]=numCols-reducedCols;
+	data->removed[2]=colStart[numCols]-matrix.getNumElements();
+	data->presolveTime=wallClock()-startTime;
+	data->postsolveTime=0;
+	presolveStates[env]=data;
+	sciprint("Presolve removed %d rows, %d columns and %d nonzeros in %.3f s.\n",(int)data->removed[0],
+		(int)data->removed[1],(int)data->removed[2],data->presolveTime);
+	return iRet;
+}
+
+//restate solution, a solution of the reduced problem, into data->colSolution and the other fields
+//unless it is the one restated last; returns false on failure
+static bool restateSolution(presolveData *data, const std::vector<double> &solution)
+{
+	double startTime=wallClock();
+	int iter,reducedCols=data->reducedCols;
+	if(solution==data->reducedSolution)
+		return true;
+	if(data->reduced==NULL)
+		return false;
+	//postsolve needs a basic solution: fix the integers at their values and solve the LP that is left
+	OsiSolverInterface *reduced=data->reduced;
+	for(iter=0;iter<reducedCols;iter++)
+		if(reduced->isInteger(iter)){
+			double rounded=floor(solution[iter]+0.5);
+			reduced->setColBounds(iter,rounded,rounded);
+		}
+	reduced->setColSolution(&solution[0]);
+	reduced->messageHandler()->setLogLevel(0);
+	try{
+		reduced->initialSolve();
+	}catch(CoinError &error){
+		return false;
+	}
+	if(!reduced->isProvenOptimal())
+		return false;
+	data->presolve->postsolve(true);
+	data->colSolution.assign(data->original->getColSolution(),data->original->getColSolution()+data->original->getNumCols());
+	data->rowActivity.assign(data->original->getRowActivity(),data->original->getRowActivity()+data->original->getNumRows());
+	data->objValue=data->original->getObjValue();
+	data->reducedSolution=solution;
+
+	//the postsolve stack is used up, build it again for the next solve; the reduced problem is the same
+	delete data->reduced;
+	delete data->presolve;
+	data->reduced=NULL;
+	data->presolve=NULL;
+	if(runPresolve(data) && (data->reduced->getNumCols()!=reducedCols || data->reduced->getNumRows()!=data->reducedRows)){
+		delete data->reduced;
+		delete data->presolve;
+		data->reduced=NULL;
+		data->presolve=NULL;
+	}
+	data->postsolveTime=wallClock()-startTime;
+	return true;
+}
+
+int presolveRestoreSolution(sym_environment *env, int *numCols, int *numRows,
+	const double **colSolution, const double **rowActivity, double *objValue)
+{
+	std::map<sym_environment*,presolveData*>::iterator found=presolveStates.find(env);
+	presolveData *data;
+
+	if(found==presolveStates.end())
+		return 0;
+	data=found->second;
+	*numCols=data->original->getNumCols();
+	*numRows=data->original->getNumRows();
+
+	//the solution of the reduced problem, which is restated only if it is a new one
+	std::vector<double> solution(data->reducedCols+1);
+	if(sym_get_col_solution(env,&solution[0])==FUNCTION_TERMINATED_ABNORMALLY)
+		return -1;
+	solution.resize(data->reducedCols);
+	if(!restateSolution(data,solution))
+		return -1;
+	*colSolution=&data->colSolution[0];
+	*rowActivity=data->rowActivity.empty()?NULL:&data->rowActivity[0];
+	*objValue=data->objValue;
+	return 1;
+}
+
+int presolveRestoreColumns(sym_environment *env, const double *reducedSolution, int *numCols,
+	const double **colSolution, double *objValue)
+{
+	std::map<sym_environment*,presolveData*>::iterator found=presolveStates.find(env);
+	presolveData *data;
+
+	if(found==presolveStates.end())
+		return 0;
+	data=found->second;
+	*numCols=data->original->getNumCols();
+	if(!restateSolution(data,std::vector<double>(reducedSolution,reducedSolution+data->reducedCols)))
+		return -1;
+	*colSolution=&data->colSolution[0];
+	*objValue=data->objValue;
+	return 1;
+}
+
+extern "C" {
+
+int sci_sym_setPresolve(char *fname){
+
+	//data declarations
+	double enable;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: whether problems are presolved when loaded
+	if(getDoubleFromScilab(1,&enable))
+		return 1;
+	presolveEnabled=(enable!=0);
+	sciprint("Presolve is %s for the problems loaded from now on.\n",presolveEnabled?"enabled":"disabled");
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_getPresolveInfo(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	double info[5]={0,0,0,0,0}; //rows, columns and nonzeros removed, presolve and postsolve time
+	std::map<sym_environment*,presolveData*>::iterator found;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	found=presolveStates.find(global_sym_env);
+	if(found!=presolveStates.end()){
+		info[0]=found->second->removed[0];
+		info[1]=found->second->removed[1];
+		info[2]=found->second->removed[2];
+		info[3]=found->second->presolveTime;
+		info[4]=found->second->postsolveTime;
+	}
+
+	//code to give output
+	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,5,info);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	return 0;
+}
+
+}
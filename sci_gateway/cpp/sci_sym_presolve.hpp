@@ -0,0 +1,36 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for presolving a problem before it is given to Symphony
+// The problem is reduced with OsiPresolve when it is loaded, and the solution of the reduced
+// problem is restated in terms of the original one when it is asked for
+
+#ifndef SCI_SYMPRESOLVEHEADER
+#define SCI_SYMPRESOLVEHEADER
+
+#include "symphony.h"
+
+//load a problem into env like sym_explicit_load_problem, presolving it first if presolve is enabled
+//objSense is only used by presolve, the caller sets the objective sense of env as usual
+int presolveLoadProblem(sym_environment *env, int numCols, int numRows, int *colStart, int *rowIndex,
+	double *value, double *lower, double *upper, char *isInt, double *objective,
+	char *rowSense, double *rowRHS, double *rowRange, int objSense);
+
+//forget the presolve data of env, to be called when env is closed
+void presolveForget(sym_environment *env);
+
+//give an error and return 1 if the problem in env is presolved, else return 0
+//to be called by the functions that take or give indices of variables or constraints, which would be those
+//of the reduced problem; only the solution, objective value and row activity are restated
+int presolveCheckIndices(sym_environment *env);
+
+//restate the solution of the problem in env in terms of the original problem
+//returns 0 if the problem in env was not presolved, 1 if the solution has been restated and -1 on failure
+//the arrays stay valid until the next call for env
+int presolveRestoreSolution(sym_environment *env, int *numCols, int *numRows,
+	const double **colSolution, const double **rowActivity, double *objValue);
+
+//restate reducedSolution, a solution of the problem in env, like presolveRestoreSolution
+//returns 0 if the problem in env was not presolved, 1 if the solution has been restated and -1 on failure
+int presolveRestoreColumns(sym_environment *env, const double *reducedSolution, int *numCols,
+	const double **colSolution, double *objValue);
+
+#endif //SCI_SYMPRESOLVEHEADER
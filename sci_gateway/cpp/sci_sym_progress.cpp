@@ -0,0 +1,558 @@
+/*
+ * Symphony Toolbox
+ * Functions for following the progress of a running solve
+ * While a solve started from Scilab runs, the solver output is passed through a pipe. A reader thread copies
+ * it to the console and turns the periodic status lines of the solver into samples, which are
+ * kept in a ring buffer for Scilab and can also be appended to a CSV or JSON-lines file.
+ * The statistics printed at the end of the solve are collected by the same thread.
+ * Nothing is captured unless monitoring has been enabled with sym_setProgress().
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_progress.hpp"
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+//settings
+static double progressInterval=0; //seconds between samples, 0 if monitoring is disabled
+static FILE *progressFile=NULL;
+static bool progressJSON=false;
+
+//capture of the solver output
+static bool progressActive=false;
+static int savedStdout=-1,pipeEnds[2];
+static pthread_t readerThread;
+
+//samples, written by the reader thread and read by Scilab without locking
+#define PROGRESS_RING_SIZE 4096
+static progressSample ring[PROGRESS_RING_SIZE];
+static volatile unsigned ringHead=0,ringTail=0,ringDropped=0;
+
+//latest sample, also used by sym_poll(), and statistics of the last finished solve
+static pthread_mutex_t lastMutex=PTHREAD_MUTEX_INITIALIZER;
+static progressSample lastSample;
+static bool haveLastSample=false;
+static solveStats currentStats,lastStats; //currentStats is only used by the reader thread
+static bool haveLastStats=false;
+static double captureStart;
+
+const char *cutGeneratorNames[NUM_CUT_GENERATORS]={"gomory","knapsack","oddhole","clique","probing","mir",
+	"twomir","flow and cover","rounding","lift and project","landp","redsplit"};
+const char *cutGeneratorFields[NUM_CUT_GENERATORS]={"gomory","knapsack","oddhole","clique","probing","mir",
+	"twomir","flowCover","rounding","liftAndProject","landp","redsplit"};
+
+//lines of the statistics block that hold a single value
+struct statsLine{
+	const char *prefix;
+	double *value;
+};
+static const statsLine statsLines[]={
+	{"Number of created nodes :",&currentStats.createdNodes},
+	{"Number of analyzed nodes:",&currentStats.analyzedNodes},
+	{"Depth of tree:",&currentStats.treeDepth},
+	{"Number of solutions found:",&currentStats.solutionsFound},
+	{"Number of cuts in cut pool:",&currentStats.cutsInPool},
+	{"Upper Bound in Root:",&currentStats.rootUpperBound},
+	{"Lower Bound in Root:",&currentStats.rootLowerBound},
+	{"Current Lower Bound:",&currentStats.lowerBound},
+	{"Current Upper Bound:",&currentStats.upperBound},
+	{"Gap Percentage:",&currentStats.gap},
+	{"LP Solution Time",&currentStats.timeLP},
+	{"Separation",&currentStats.timeCuts},
+	{"Strong Branching",&currentStats.timeBranching},
+	{"Primal Heuristics",&currentStats.timeHeuristics},
+	{"Total Wallclock Time",&currentStats.timeTotal},
+	{"time in cut generation:",&currentStats.timeCuts}
+};
+
+static double wallClock()
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec+now.tv_usec*1e-6;
+}
+
+static void resetStats(solveStats *stats)
+{
+	double *value=(double*)stats;
+	unsigned iter;
+	for(iter=0;iter<sizeof(solveStats)/sizeof(double);iter++)
+		value[iter]=NAN;
+}
+
+//read the number that follows prefix in line, returns false if line does not start with prefix
+static bool readValue(const char *line, const char *prefix, double *value)
+{
+	size_t length=strlen(prefix);
+	char *end;
+	double result;
+	if(strncmp(line,prefix,length)!=0)
+		return false;
+	result=strtod(line+length,&end);
+	if(end==line+length)
+		return false;
+	*value=result;
+	return true;
+}
+
+static void parseStatsLine(const char *line)
+{
+	char prefix[64];
+	double value;
+	int calls,iter;
+	while(*line==' ' || *line=='\t')
+		line++;
+	for(iter=0;iter<(int)(sizeof(statsLines)/sizeof(statsLine));iter++)
+		if(readValue(line,statsLines[iter].prefix,statsLines[iter].value))
+			return;
+	//nodes pruned by strong branching and by the branching presolver are counted together
+	if(readValue(line,"Number of nodes pruned by strong branching:",&value) ||
+		readValue(line,"Number of nodes pruned by branching presolver:",&value)){
+		currentStats.prunedNodes=(isnan(currentStats.prunedNodes)?0:currentStats.prunedNodes)+value;
+		return;
+	}
+	for(iter=0;iter<NUM_CUT_GENERATORS;iter++){
+		sprintf(prefix,"total %s cuts generated:",cutGeneratorNames[iter]);
+		if(readValue(line,prefix,&currentStats.cutsGenerated[iter]))
+			return;
+		sprintf(prefix,"%s cuts in root:",cutGeneratorNames[iter]);
+		if(readValue(line,prefix,&currentStats.cutsInRoot[iter]))
+			return;
+		sprintf(prefix,"time in %s cuts in %%d calls: %%lf",cutGeneratorNames[iter]);
+		if(sscanf(line,prefix,&calls,&value)==2){
+			currentStats.cutCalls[iter]=calls;
+			currentStats.cutTime[iter]=value;
+			return;
+		}
+	}
+	//the solver announces every improvement of the incumbent while it runs
+	if(isnan(currentStats.timeToFirstFeasible) && (strstr(line,"Better Solution Found") ||
+		strstr(line,"Found Better Feasible Solution") || strstr(line,"Found Another Feasible Solution")))
+		currentStats.timeToFirstFeasible=wallClock()-captureStart;
+}
+
+static void pushSample(progressSample *sample)
+{
+	if(ringHead-ringTail>=PROGRESS_RING_SIZE)
+		__sync_fetch_and_add(&ringDropped,1); //nobody has read the buffer for a long time, keep the oldest samples
+	else{
+		ring[ringHead%PROGRESS_RING_SIZE]=*sample;
+		__sync_synchronize(); //the sample must be complete before it becomes visible
+		ringHead++;
+	}
+	pthread_mutex_lock(&lastMutex);
+	lastSample=*sample;
+	haveLastSample=true;
+	pthread_mutex_unlock(&lastMutex);
+}
+
+static void writeValue(const char *name, double value, bool last)
+{
+	if(progressJSON){
+		if(isnan(value))
+			fprintf(progressFile,"\"%s\":null%s",name,last?"}\n":",");
+		else
+			fprintf(progressFile,"\"%s\":%.10g%s",name,value,last?"}\n":",");
+	}else{
+		if(!isnan(value))
+			fprintf(progressFile,"%.10g",value);
+		fprintf(progressFile,last?"\n":",");
+	}
+}
+
+static void writeSample(progressSample *sample)
+{
+	if(progressJSON)
+		fprintf(progressFile,"{");
+	writeValue("time",sample->time,false);
+	writeValue("incumbent",sample->incumbent,false);
+	writeValue("bound",sample->bound,false);
+	writeValue("gap",sample->gap,false);
+	writeValue("open_nodes",sample->openNodes,false);
+	writeValue("done_nodes",sample->doneNodes,false);
+	writeValue("node_rate",sample->nodeRate,true);
+	fflush(progressFile);
+}
+
+//status lines are printed by print_tree_status() of the solver in one of two layouts:
+//- after a header line naming the columns Time, Done and Queued, "%7i %10i %10i " for the time and the analyzed
+//  and queued nodes, "%19.2f " or "%19s " for the bound and then for the incumbent, and "%7.2f " or "%9s " for the gap
+//- at low verbosity, "done: %i left: %i ", the incumbent and then the bound as "ub: %.2f " or "lb: %.2f ", or with
+//  "??" while unknown, "gap: %.2f " once both are known and "time: %i"
+#define STATUS_COLUMNS 5
+static const int statusStart[STATUS_COLUMNS]={0,8,19,30,50},statusWidth[STATUS_COLUMNS]={7,10,10,19,19};
+#define STATUS_GAP_START 70
+
+static bool isStatusHeader(const char *line)
+{
+	while(*line==' ')
+		line++;
+	return strncmp(line,"Time ",5)==0 && strstr(line," Done ") && strstr(line," Queued");
+}
+
+//read a number printed as %i if decimals is 0, or as %.2f, from the length characters at text, with leading spaces
+//returns 1 for a number, 0 if they are all spaces and -1 if they do not have this format
+static int readPrinted(const char *text, int length, int decimals, double *value)
+{
+	int pos=0,digits=0,fraction=-1;
+	while(pos<length && text[pos]==' ')
+		pos++;
+	if(pos==length)
+		return 0;
+	*value=strtod(text+pos,NULL);
+	if(text[pos]=='-')
+		pos++;
+	for(;pos<length;pos++){
+		if(text[pos]>='0' && text[pos]<='9'){
+			if(fraction>=0)
+				fraction++;
+			else
+				digits++;
+		}else if(text[pos]=='.' && fraction<0)
+			fraction=0;
+		else
+			return -1;
+	}
+	if(digits==0 || fraction!=(decimals?decimals:-1))
+		return -1;
+	return 1;
+}
+
+static bool parseStatusColumns(const char *line, int length, progressSample *sample)
+{
+	double values[STATUS_COLUMNS];
+	int found[STATUS_COLUMNS],iter,last;
+	for(iter=0;iter<STATUS_COLUMNS;iter++){
+		last=statusStart[iter]+statusWidth[iter];
+		if(length<=statusStart[iter])
+			found[iter]=0;	//trailing blank columns
+		else if(length<last || (length>last && line[last]!=' ') ||
+			(found[iter]=readPrinted(line+statusStart[iter],statusWidth[iter],iter<3?0:2,&values[iter]))<0)
+			return false;
+	}
+	for(iter=0;iter<3;iter++)
+		if(found[iter]!=1 || values[iter]<0)
+			return false;
+	sample->time=values[0];
+	sample->doneNodes=values[1];
+	sample->openNodes=values[2];
+	sample->bound=found[3]?values[3]:NAN;
+	sample->incumbent=found[4]?values[4]:NAN;
+	sample->gap=NAN;
+	//the gap is the last column, which a large value widens
+	if(length>STATUS_GAP_START && readPrinted(line+STATUS_GAP_START,length-STATUS_GAP_START,2,&sample->gap)!=1)
+		return false;
+	return true;
+}
+
+//read "label: " and a number printed as %i if decimals is 0, or as %.2f, followed by a space or the end of the
+//line; a value of "??" is read as NaN if unknown is true
+static bool readLabelled(const char **pos, const char *label, int decimals, bool unknown, double *value)
+{
+	size_t length=strlen(label);
+	const char *end;
+	if(strncmp(*pos,label,length)!=0 || strncmp(*pos+length,": ",2)!=0)
+		return false;
+	*pos+=length+2;
+	for(end=*pos;*end!='\0' && *end!=' ';end++);
+	if(unknown && end-*pos==2 && strncmp(*pos,"??",2)==0)
+		*value=NAN;
+	else if(readPrinted(*pos,end-*pos,decimals,value)!=1)
+		return false;
+	*pos=(*end==' ')?end+1:end;
+	return true;
+}
+
+static bool parseStatusCompact(const char *line, progressSample *sample)
+{
+	const char *pos=line;
+	const char *incumbentLabel;
+	if(!readLabelled(&pos,"done",0,false,&sample->doneNodes) || !readLabelled(&pos,"left",0,false,&sample->openNodes))
+		return false;
+	//the incumbent is an upper bound of a minimization and a lower bound of a maximization
+	incumbentLabel=(strncmp(pos,"ub: ",4)==0)?"ub":"lb";
+	if(!readLabelled(&pos,incumbentLabel,2,true,&sample->incumbent) ||
+		!readLabelled(&pos,incumbentLabel[0]=='u'?"lb":"ub",2,true,&sample->bound))
+		return false;
+	sample->gap=NAN;
+	if(strncmp(pos,"gap: ",5)==0 && !readLabelled(&pos,"gap",2,false,&sample->gap))
+		return false;
+	return readLabelled(&pos,"time",0,false,&sample->time) && *pos=='\0';
+}
+
+static bool parseStatusLine(const char *line, bool headerSeen, progressSample *sample, progressSample *previous)
+{
+	int length=strlen(line);
+	while(length>0 && line[length-1]==' ')
+		length--;
+	if(strncmp(line,"done: ",6)==0){
+		if(!parseStatusCompact(line,sample))
+			return false;
+	}else if(!headerSeen || !parseStatusColumns(line,length,sample))
+		return false;
+	if(previous->time>=0 && sample->time>previous->time)
+		sample->nodeRate=(sample->doneNodes-previous->doneNodes)/(sample->time-previous->time);
+	else
+		sample->nodeRate=NAN;
+	return true;
+}
+
+static void *readerLoop(void *arg)
+{
+	char buffer[4096],line[1024];
+	int lineLength=0,iter;
+	ssize_t count,written,offset;
+	bool headerSeen=false;
+	progressSample sample,previous;
+	previous.time=-1;
+	while((count=read(pipeEnds[0],buffer,sizeof(buffer)))>0){
+		//pass everything on to the console first
+		for(offset=0;offset<count;offset+=written){
+			written=write(savedStdout,buffer+offset,count-offset);
+			if(written<=0)
+				break;
+		}
+		for(iter=0;iter<count;iter++){
+			if(buffer[iter]!='\n'){
+				if(lineLength<(int)sizeof(line)-1)
+					line[lineLength++]=buffer[iter];
+				continue;
+			}
+			line[lineLength]='\0';
+			lineLength=0;
+			if(isStatusHeader(line))
+				headerSeen=true;
+			else if(parseStatusLine(line,headerSeen,&sample,&previous)){
+				if(isnan(currentStats.timeToFirstFeasible) && !isnan(sample.incumbent))
+					currentStats.timeToFirstFeasible=wallClock()-captureStart;
+				if(progressInterval>0){
+					pushSample(&sample);
+					if(progressFile)
+						writeSample(&sample);
+				}
+				previous=sample;
+			}else
+				parseStatsLine(line);
+		}
+	}
+	return NULL;
+}
+
+void progressSkip()
+{
+	//the statistics of an earlier solve do not belong to this one
+	pthread_mutex_lock(&lastMutex);
+	haveLastStats=false;
+	pthread_mutex_unlock(&lastMutex);
+}
+
+int progressBegin(sym_environment *env)
+{
+	if(progressActive)
+		return 0;
+	if(progressInterval<=0){
+		progressSkip();
+		return 0;
+	}
+	sym_set_dbl_param(env,"status_interval",progressInterval);
+	fflush(stdout);
+	if(pipe(pipeEnds))
+		return 0;
+	savedStdout=dup(STDOUT_FILENO);
+	if(savedStdout<0 || dup2(pipeEnds[1],STDOUT_FILENO)<0){
+		if(savedStdout>=0)
+			close(savedStdout);
+		close(pipeEnds[0]);
+		close(pipeEnds[1]);
+		return 0;
+	}
+	close(pipeEnds[1]);
+	pthread_mutex_lock(&lastMutex);
+	haveLastSample=false;
+	pthread_mutex_unlock(&lastMutex);
+	resetStats(&currentStats);
+	captureStart=wallClock();
+	if(pthread_create(&readerThread,NULL,readerLoop,NULL)){
+		dup2(savedStdout,STDOUT_FILENO);
+		close(savedStdout);
+		close(pipeEnds[0]);
+		return 0;
+	}
+	progressActive=true;
+	return 1;
+}
+
+void progressEnd()
+{
+	if(!progressActive)
+		return;
+	//restoring stdout closes the last write end of the pipe, so the reader sees the end of it
+	fflush(stdout);
+	dup2(savedStdout,STDOUT_FILENO);
+	close(savedStdout);
+	pthread_join(readerThread,NULL);
+	close(pipeEnds[0]);
+	pthread_mutex_lock(&lastMutex);
+	lastStats=currentStats;
+	haveLastStats=true;
+	pthread_mutex_unlock(&lastMutex);
+	progressActive=false;
+}
+
+int progressLastSample(progressSample *dest)
+{
+	int found;
+	pthread_mutex_lock(&lastMutex);
+	found=haveLastSample;
+	if(found)
+		*dest=lastSample;
+	pthread_mutex_unlock(&lastMutex);
+	return found;
+}
+
+int progressLastStats(solveStats *dest)
+{
+	int found;
+	pthread_mutex_lock(&lastMutex);
+	found=haveLastStats;
+	if(found)
+		*dest=lastStats;
+	pthread_mutex_unlock(&lastMutex);
+	return found;
+}
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+
+int sci_sym_setProgress(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	int *varAddress,nameLength;
+	double interval;
+	char *fileName=NULL;
+	FILE *newFile=NULL;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,2) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(progressActive){
+		Scierror(999, "The progress settings cannot be changed while a solve is running.\n");
+		return 1;
+	}
+
+	//get input 1: interval between samples in seconds, 0 to disable
+	if(getDoubleFromScilab(1,&interval))
+		return 1;
+	if(interval<0){
+		Scierror(999, "Wrong value for input argument #1: A non-negative interval is expected.\n");
+		return 1;
+	}
+
+	//get input 2: file to which the samples are appended
+	if(nbInputArgument(pvApiCtx)==2){
+		sciErr = getVarAddressFromPosition(pvApiCtx, 2, &varAddress);
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			return 1;
+		}
+		if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &fileName) )
+		{
+			Scierror(999, "Wrong type for input argument #2: A file name is expected.\n");
+			return 1;
+		}
+		newFile=fopen(fileName,"a");
+		nameLength=strlen(fileName);
+		progressJSON=(nameLength>5 && strcmp(fileName+nameLength-5,".json")==0) ||
+			(nameLength>6 && strcmp(fileName+nameLength-6,".jsonl")==0);
+		freeAllocatedSingleString(fileName);
+		if(newFile==NULL){
+			Scierror(999, "Unable to open the progress file for writing.\n");
+			return 1;
+		}
+		if(!progressJSON && ftell(newFile)==0)
+			fprintf(newFile,"time,incumbent,bound,gap,open_nodes,done_nodes,node_rate\n");
+	}
+
+	if(progressFile)
+		fclose(progressFile);
+	progressFile=newFile;
+	progressInterval=interval;
+	if(interval>0 && global_sym_env!=NULL)
+		sym_set_dbl_param(global_sym_env,"status_interval",interval);
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_getProgress(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	unsigned head,tail,numSamples,iter;
+	double *samples,dropped;
+	progressSample *sample;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,2) ;
+
+	//take all samples written so far
+	head=ringHead;
+	__sync_synchronize();
+	tail=ringTail;
+	numSamples=head-tail;
+	samples=new double[numSamples*7+1];
+	for(iter=0;iter<numSamples;iter++){
+		sample=&ring[(tail+iter)%PROGRESS_RING_SIZE];
+		samples[iter]=sample->time;
+		samples[numSamples+iter]=sample->incumbent;
+		samples[2*numSamples+iter]=sample->bound;
+		samples[3*numSamples+iter]=sample->gap;
+		samples[4*numSamples+iter]=sample->openNodes;
+		samples[5*numSamples+iter]=sample->doneNodes;
+		samples[6*numSamples+iter]=sample->nodeRate;
+	}
+	__sync_synchronize(); //the samples must be read before their slots are given back
+	ringTail=head;
+	dropped=__sync_lock_test_and_set(&ringDropped,0);
+
+	//code to give output
+	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numSamples,numSamples?7:0,samples);
+	delete[] samples;
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+	if(nbOutputArgument(pvApiCtx)==2){
+		if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,dropped))
+			return 1;
+		AssignOutputVariable(pvApiCtx,2)=nbInputArgument(pvApiCtx)+2;
+	}
+
+	return 0;
+}
+
+}
@@ -0,0 +1,53 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for following the progress of a running solve
+// When monitoring is enabled, the solver output is captured while a solve started from Scilab runs:
+// its status lines are turned into samples and the statistics it prints at the end are collected
+
+#ifndef SCI_SYMPROGRESSHEADER
+#define SCI_SYMPROGRESSHEADER
+
+#include "symphony.h"
+
+//one sample of the status of a running solve
+struct progressSample{
+	double time;		//seconds since the solve was started, as reported by the solver
+	double incumbent;	//objective value of the best solution found, NaN if none
+	double bound;		//best known bound on the optimal objective value
+	double gap;			//gap between incumbent and bound, in percent, NaN if unknown
+	double openNodes;	//nodes waiting to be processed
+	double doneNodes;	//nodes processed so far
+	double nodeRate;	//nodes processed per second since the previous sample, NaN for the first one
+};
+
+//cut generators, in the order in which the solver reports them
+#define NUM_CUT_GENERATORS 12
+extern const char *cutGeneratorNames[NUM_CUT_GENERATORS];
+//names of the cut generators as the toolbox functions take and return them
+extern const char *cutGeneratorFields[NUM_CUT_GENERATORS];
+
+//statistics of a finished solve, NaN for everything the solver did not print
+struct solveStats{
+	double createdNodes,analyzedNodes,prunedNodes,treeDepth;
+	double solutionsFound,cutsInPool;
+	double rootUpperBound,rootLowerBound;
+	double lowerBound,upperBound,gap;	//at the end of the solve, gap in percent
+	double timeLP,timeCuts,timeBranching,timeHeuristics,timeTotal;
+	double timeToFirstFeasible;		//wall clock seconds from the start of the solve
+	double cutsGenerated[NUM_CUT_GENERATORS],cutsInRoot[NUM_CUT_GENERATORS];
+	double cutCalls[NUM_CUT_GENERATORS],cutTime[NUM_CUT_GENERATORS];
+};
+
+//start capturing the output of a solve on env, if monitoring is enabled
+//returns 1 if capturing has started, in which case progressEnd must be called after the solve
+int progressBegin(sym_environment *env);
+//stop capturing
+void progressEnd();
+//forget the statistics of the last solve before a solve that is not captured, as a background one,
+//whose output goes to the console while Scilab keeps running
+void progressSkip();
+//copy the latest sample of the current or last solve to dest, returns 0 if there is none
+int progressLastSample(progressSample *dest);
+//copy the statistics of the last finished solve to dest, returns 0 if there is none or it was not captured
+int progressLastStats(solveStats *dest);
+
+#endif //SCI_SYMPROGRESSHEADER
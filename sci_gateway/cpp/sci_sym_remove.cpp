@@ -5,6 +5,7 @@
  * By Iswarya
  */
 #include <symphony.h>
+#include "sci_sym_presolve.hpp"
 
 extern sym_environment* global_sym_env;//defined in globals.cpp
 
@@ -72,6 +73,8 @@ int sci_sym_delete_cols(char *fname, unsigned long fname_len){
 	if(global_sym_env==NULL){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 		}
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else {
 		int flag=0;//flag used for finding if the indices to be deleted are valid
 		output=sym_get_num_cols(global_sym_env,&num_cols);//function to find the number of columns in the loaded problem
@@ -188,6 +191,8 @@ int sci_sym_delete_rows(char *fname, unsigned long fname_len){
 	if(global_sym_env==NULL){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 		}
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else {
 		output=sym_get_num_rows(global_sym_env,&num_rows);//function to find the number of rows in the loaded problem
 		if(output==FUNCTION_TERMINATED_ABNORMALLY)
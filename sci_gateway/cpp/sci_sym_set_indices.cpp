@@ -6,6 +6,7 @@
  */
 #include <symphony.h>
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
 
 extern sym_environment* global_sym_env;//defined in globals.cpp
 
@@ -34,6 +35,8 @@ int sci_sym_set_continuous(char *fname, unsigned long fname_len){
 	if(global_sym_env==NULL){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 	}
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else
 	{
 		output=sym_set_continuous(global_sym_env,index);//setting the variable continuous
@@ -74,6 +77,8 @@ int sci_sym_set_integer(char *fname, unsigned long fname_len){
 	if(global_sym_env==NULL){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 	}
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else
 	{
 		output=sym_set_integer(global_sym_env,index);//setting the variable continuous
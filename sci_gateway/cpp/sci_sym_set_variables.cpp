@@ -14,6 +14,9 @@ extern "C" {
 #include <BOOL.h>
 #include <localization.h>
 #include <sciprint.h>
+
+void threadsSetDefault(sym_environment *env); //defined in sci_sym_threads.cpp
+
 //This function is for loading a mps file to symphony
 int sci_sym_set_defaults(char *fname, unsigned long fname_len){
 	
@@ -36,6 +39,7 @@ int sci_sym_set_defaults(char *fname, unsigned long fname_len){
 		}
 		else if(output==FUNCTION_TERMINATED_NORMALLY)
 		{
+			threadsSetDefault(global_sym_env);
 			status=0.0;//no error in executing the function
 			sciprint("Function executed successfully");
 		}
@@ -6,6 +6,7 @@
 
 #include "symphony.h"
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
 
 extern sym_environment* global_sym_env; //defined in globals.cpp
 
@@ -31,6 +32,8 @@ int sci_sym_setObjCoeff(char *fname){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 		return 1;
 	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
 	
 	//code to check arguments and get them
 	CheckInputArgument(pvApiCtx,2,2) ;
@@ -1,10 +1,13 @@
 /*
  * Symphony Toolbox
- * Provides the solution after the problem is solved
+ * Provides the solution after the problem is solved, and the other solutions Symphony kept in its solution pool
  * By Keyur Joshi
  */
 #include "symphony.h"
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include <algorithm>
+#include <vector>
 
 extern sym_environment* global_sym_env; //defined in globals.cpp
 
@@ -22,8 +25,9 @@ int sci_sym_getVarSoln(char *fname){
 	int iRet;
 	
 	//data declarations
-	int numVars;
-	double *solution;
+	int numVars,numConstr;
+	double *solution,objVal;
+	const double *restored,*rowAct;
 	
 	//ensure that environment is active
 	if(global_sym_env==NULL){
@@ -35,33 +39,45 @@ int sci_sym_getVarSoln(char *fname){
 	CheckInputArgument(pvApiCtx,0,0) ;
 	CheckOutputArgument(pvApiCtx,1,1) ;
 	
+	//a presolved problem gives the solution of the original problem
+	iRet=presolveRestoreSolution(global_sym_env,&numVars,&numConstr,&restored,&rowAct,&objVal);
+	if(iRet<0){
+		Scierror(999, "An error occured while restoring the solution of the presolved problem. Has the problem been solved?\n");
+		return 1;
+	}
+	if(iRet){
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,numVars,restored);
+		if (sciErr.iErr)
+		{
+			printError(&sciErr, 0);
+			return 1;
+		}
+		AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx)+1;
+		return 0;
+	}
+
 	//code to process input
 	iRet=sym_get_num_cols(global_sym_env,&numVars);
 	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
 		Scierror(999, "An error occured. Has the problem been loaded and solved?\n");
 		return 1;
 	}
-	solution=new double[numVars];
-	iRet=sym_get_col_solution(global_sym_env,solution);
-	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
-		//Scierror(999, "An error occured. Has the problem been solved? Is the problem feasible?\n");
-		delete[] solution;
-		return 1;
-	}
 	
-	//code to give output
-	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,numVars,solution);
+	//code to give output: symphony writes the solution straight into the output variable
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,numVars,&solution);
 	if (sciErr.iErr)
 	{
 		printError(&sciErr, 0);
-		delete[] solution;
+		return 1;
+	}
+	iRet=sym_get_col_solution(global_sym_env,solution);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		//Scierror(999, "An error occured. Has the problem been solved? Is the problem feasible?\n");
 		return 1;
 	}
 	AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx)+1;
 	//ReturnArguments(pvApiCtx);
 	
-	delete[] solution;
-	
 	return 0;
 }
 
@@ -73,6 +89,8 @@ int sci_sym_getObjVal(char *fname){
 	
 	//data declarations
 	double solution;
+	int numVars,numConstr;
+	const double *colSol,*rowAct;
 	
 	//ensure that environment is active
 	if(global_sym_env==NULL){
@@ -84,6 +102,18 @@ int sci_sym_getObjVal(char *fname){
 	CheckInputArgument(pvApiCtx,0,0) ;
 	CheckOutputArgument(pvApiCtx,1,1) ;
 	
+	//a presolved problem gives the objective value of the original problem, with the part presolve removed
+	iRet=presolveRestoreSolution(global_sym_env,&numVars,&numConstr,&colSol,&rowAct,&solution);
+	if(iRet<0){
+		Scierror(999, "An error occured while restoring the solution of the presolved problem. Has the problem been solved?\n");
+		return 1;
+	}
+	if(iRet){
+		if(returnDoubleToScilab(solution))
+			return 1;
+		return 0;
+	}
+
 	//code to process input
 	iRet=sym_get_obj_val(global_sym_env,&solution);
 	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
@@ -98,4 +128,111 @@ int sci_sym_getObjVal(char *fname){
 	return 0;
 }
 
+//a solution of the pool, key is the objective value as symphony minimizes it
+struct poolEntry{
+	double key,objVal;
+	std::vector<double> solution;
+};
+
+static bool betterPoolEntry(const poolEntry &first, const poolEntry &second)
+{
+	return first.key<second.key;
+}
+
+int sci_sym_getSolutionPool(char *fname){
+	
+	//error management variable
+	SciErr sciErr;
+	int iRet;
+	
+	//data declarations
+	int numVars,restoredVars,poolSize,objSense,iter,col,numSolutions;
+	double maxCount=-1,objVal,*values;
+	const double *restored;
+	std::vector<poolEntry> pool;
+	
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,1) ;
+	CheckOutputArgument(pvApiCtx,1,2) ;
+	
+	//get input 1: the number of best solutions wanted
+	if(nbInputArgument(pvApiCtx)==1){
+		if(getDoubleFromScilab(1,&maxCount))
+			return 1;
+		if(maxCount<0 || maxCount!=(int)maxCount){
+			Scierror(999, "Wrong value for input argument #1: A non-negative integer is expected.\n");
+			return 1;
+		}
+	}
+	
+	//code to process input
+	if(sym_get_num_cols(global_sym_env,&numVars)==FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_sense(global_sym_env,&objSense)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has the problem been loaded and solved?\n");
+		return 1;
+	}
+	if(sym_get_sp_size(global_sym_env,&poolSize)==FUNCTION_TERMINATED_ABNORMALLY)
+		poolSize=0;
+	std::vector<double> objective(numVars+1),solution(numVars+1);
+	sym_get_obj_coeff(global_sym_env,&objective[0]);
+	for(col=0;col<numVars;col++)
+		objective[col]*=objSense;	//symphony gives the objective of a maximization negated
+	for(iter=0;iter<poolSize;iter++){
+		poolEntry entry;
+		if(sym_get_sp_solution(global_sym_env,iter,&solution[0],&objVal)==FUNCTION_TERMINATED_ABNORMALLY)
+			continue;
+		//a presolved problem gives the solutions of the original problem
+		iRet=presolveRestoreColumns(global_sym_env,&solution[0],&restoredVars,&restored,&entry.objVal);
+		if(iRet<0){
+			Scierror(999, "An error occured while restoring a solution of the presolved problem.\n");
+			return 1;
+		}
+		if(iRet)
+			entry.solution.assign(restored,restored+restoredVars);
+		else{
+			//the objective value is computed from the solution, with the objective as it was given
+			entry.solution.assign(solution.begin(),solution.begin()+numVars);
+			entry.objVal=0;
+			for(col=0;col<numVars;col++)
+				entry.objVal+=objective[col]*solution[col];
+		}
+		entry.key=objSense*entry.objVal;
+		pool.push_back(entry);
+	}
+	std::stable_sort(pool.begin(),pool.end(),betterPoolEntry);
+	if(maxCount>=0 && pool.size()>(size_t)maxCount)
+		pool.resize((size_t)maxCount);
+	numSolutions=pool.size();
+	
+	//code to give output: the objective values as a column, the solutions as the rows of a matrix, the best first
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numSolutions,numSolutions?1:0,&values);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=0;iter<numSolutions;iter++)
+		values[iter]=pool[iter].objVal;
+	restoredVars=numSolutions?pool[0].solution.size():0;
+	sciErr=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,numSolutions,restoredVars,&values);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=0;iter<numSolutions;iter++)
+		for(col=0;col<restoredVars;col++)
+			values[iter+col*numSolutions]=pool[iter].solution[col];
+	AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx)+1;
+	AssignOutputVariable(pvApiCtx, 2) = nbInputArgument(pvApiCtx)+2;
+	
+	return 0;
+}
+
 }
@@ -6,6 +6,9 @@
 
 #include <symphony.h>
 #include <sci_iofunc.hpp>
+#include "sci_sym_progress.hpp"
+#include "sci_sym_heuristics.hpp"
+#include "sci_sym_checkpoint.hpp"
 extern sym_environment* global_sym_env;//defined in globals.cpp
 
 extern "C" {
@@ -16,6 +19,7 @@ extern "C" {
 #include <sciprint.h>
 #include <stdio.h>
 int process_ret_val(int);
+int interruptible_solve(sym_environment*,int);
 
 int sci_sym_solve(char *fname, unsigned long fname_len){
 	
@@ -36,7 +40,17 @@ int sci_sym_solve(char *fname, unsigned long fname_len){
 			if ( time_limit < 0.0 )
 				sciprint("\nNote: There is no limit on time.\n");
 			else sciprint("\nNote: Time limit has been set to %lf.\n",time_limit);
-			status=process_ret_val(sym_solve(global_sym_env));// Call function	
+			// Start from the solution of the heuristics if asked to
+			if(heuristicsEnabled())
+				heuristicsRun(global_sym_env,heuristicsTimeLimit(),NULL,NULL);
+			int capturing=progressBegin(global_sym_env);// Follow progress if asked to
+			if(checkpointEnabled())// Write checkpoints along the way if asked to
+				status=checkpointSolve(global_sym_env,0);
+			else
+				status=interruptible_solve(global_sym_env,0);// Call function, Ctrl-C stops it and keeps the incumbent
+			if(capturing)
+				progressEnd();
+			status=process_ret_val(status);
 			}
 		else {
 			sciprint("\nUnable to read time limit.\n");
@@ -0,0 +1,108 @@
+/*
+ * Symphony Toolbox
+ * Provides the statistics of the last solve as a structure
+ * The node count, the incumbent and the status are asked from Symphony; the other statistics are only
+ * known when the solver output was captured, with monitoring enabled by sym_setProgress()
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_progress.hpp"
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <math.h>
+
+//field names of the structure, in the order of solveStats
+#define NUM_STATS_FIELDS 17
+static const char *statsFieldNames[NUM_STATS_FIELDS]={"createdNodes","analyzedNodes","prunedNodes","treeDepth",
+	"solutionsFound","cutsInPool","rootUpperBound","rootLowerBound","lowerBound","upperBound","gap",
+	"timeLP","timeCuts","timeBranching","timeHeuristics","timeTotal","timeToFirstFeasible"};
+
+int sci_sym_getStats(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	solveStats stats;
+	const char *fieldNames[NUM_STATS_FIELDS+3];
+	const char *cutNames[NUM_CUT_GENERATORS+2];
+	int *listAddress,*cutsAddress,dims[2]={1,1},iter,status,nodes;
+	double *values=(double*)&stats,objVal,cutValues[4];
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	if(!progressLastStats(&stats))
+		for(iter=0;iter<(int)(sizeof(solveStats)/sizeof(double));iter++)
+			values[iter]=NAN;
+
+	//what Symphony can be asked for directly is taken from it, not from its output
+	status=sym_get_status(global_sym_env);
+	if(sym_get_iteration_count(global_sym_env,&nodes)!=FUNCTION_TERMINATED_ABNORMALLY)
+		stats.analyzedNodes=nodes;
+	if(sym_get_obj_val(global_sym_env,&objVal)!=FUNCTION_TERMINATED_ABNORMALLY && status!=TM_NO_SOLUTION &&
+		status!=PREP_NO_SOLUTION && status!=TM_NO_PROBLEM){
+		stats.upperBound=objVal;
+		if(status==TM_OPTIMAL_SOLUTION_FOUND || status==PREP_OPTIMAL_SOLUTION_FOUND){
+			stats.lowerBound=objVal;
+			stats.gap=0;
+		}
+	}
+
+	//code to give output: a structure is an mlist of type "st"
+	fieldNames[0]="st";
+	fieldNames[1]="dims";
+	for(iter=0;iter<NUM_STATS_FIELDS;iter++)
+		fieldNames[iter+2]=statsFieldNames[iter];
+	fieldNames[NUM_STATS_FIELDS+2]="cuts";
+	sciErr=createMList(pvApiCtx,nbInputArgument(pvApiCtx)+1,NUM_STATS_FIELDS+3,&listAddress);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfStringInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,1,1,NUM_STATS_FIELDS+3,fieldNames);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfInteger32InList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,2,1,2,dims);
+	for(iter=0;iter<NUM_STATS_FIELDS && !sciErr.iErr;iter++)
+		sciErr=createMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,iter+3,1,1,&values[iter]);
+
+	//cuts: one field per generator holding [generated, in root, calls, time]
+	cutNames[0]="st";
+	cutNames[1]="dims";
+	for(iter=0;iter<NUM_CUT_GENERATORS;iter++)
+		cutNames[iter+2]=cutGeneratorFields[iter];
+	if(!sciErr.iErr)
+		sciErr=createMListInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,listAddress,NUM_STATS_FIELDS+3,NUM_CUT_GENERATORS+2,&cutsAddress);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfStringInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,cutsAddress,1,1,NUM_CUT_GENERATORS+2,cutNames);
+	if(!sciErr.iErr)
+		sciErr=createMatrixOfInteger32InList(pvApiCtx,nbInputArgument(pvApiCtx)+1,cutsAddress,2,1,2,dims);
+	for(iter=0;iter<NUM_CUT_GENERATORS && !sciErr.iErr;iter++){
+		cutValues[0]=stats.cutsGenerated[iter];
+		cutValues[1]=stats.cutsInRoot[iter];
+		cutValues[2]=stats.cutCalls[iter];
+		cutValues[3]=stats.cutTime[iter];
+		sciErr=createMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,cutsAddress,iter+3,1,4,cutValues);
+	}
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	AssignOutputVariable(pvApiCtx,1)=nbInputArgument(pvApiCtx)+1;
+
+	return 0;
+}
+
+}
@@ -0,0 +1,282 @@
+/*
+ * Symphony Toolbox
+ * Parametric sweep: re-solve the loaded problem over a grid of right hand sides
+ * or objective coefficients, using warm starts between consecutive grid points
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
+#include "globals.hpp"
+#include <pthread.h>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <string.h>
+#include <math.h>
+
+//work given to one thread: a contiguous range of grid points, solved on a private copy of the environment
+//the threads solve in one group, see globals.hpp, so Ctrl-C stops all of them
+struct sweepWork{
+	sym_environment *env;
+	bool isRHS;
+	int numIndices,*indices,numPoints,firstPoint,lastPoint,numVars;
+	double *grid; //numPoints by numIndices, column-major as in scilab
+	char *rowSense;
+	double *rowRange;
+	double *objVals,*solutions,*statuses; //outputs, each thread writes only its own rows
+	bool failed;
+};
+
+//whether a solve with this status ended its search, so that the solution held by the environment is its own
+static bool sweepFinished(int status)
+{
+	return status==TM_OPTIMAL_SOLUTION_FOUND || status==PREP_OPTIMAL_SOLUTION_FOUND ||
+		status==TM_TARGET_GAP_ACHIEVED || status==TM_FOUND_FIRST_FEASIBLE;
+}
+
+static void *sweepThread(void *arg)
+{
+	sweepWork *work=(sweepWork*)arg;
+	int point,iter,index,iRet,status;
+	bool warm=false,refused=false;
+	double *solution=new double[work->numVars];
+	for(point=work->firstPoint;point<work->lastPoint && !solve_group_stopping();point++)
+	{
+		//change the problem to this grid point
+		for(iter=0,iRet=FUNCTION_TERMINATED_NORMALLY;iter<work->numIndices && iRet!=FUNCTION_TERMINATED_ABNORMALLY;iter++)
+		{
+			index=work->indices[iter];
+			if(work->isRHS)
+				iRet=sym_set_row_type(work->env,index,work->rowSense[index],work->grid[iter*work->numPoints+point],work->rowRange[index]);
+			else
+				iRet=sym_set_obj_coeff(work->env,index,work->grid[iter*work->numPoints+point]);
+		}
+		if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+			work->failed=true;
+			break;
+		}
+		//the first point of the range is solved from scratch, the others start from the previous tree
+		//symphony refuses a warm start after some changes, as of the right hand side when cuts are generated;
+		//the settings do not change along the sweep, so the rest of the range is then solved from scratch
+		status=group_solve(work->env,warm);
+		if(warm && status==FUNCTION_TERMINATED_ABNORMALLY){
+			refused=true;
+			status=group_solve(work->env,0);
+		}
+		warm=!refused;
+		work->statuses[point]=status;
+		//a solve that did not finish leaves the solution of the previous point in the environment
+		if(!sweepFinished(status) ||
+			sym_get_obj_val(work->env,&work->objVals[point])==FUNCTION_TERMINATED_ABNORMALLY ||
+			sym_get_col_solution(work->env,solution)==FUNCTION_TERMINATED_ABNORMALLY)
+		{
+			work->objVals[point]=NAN;
+			for(iter=0;iter<work->numVars;iter++)
+				solution[iter]=NAN;
+		}
+		for(iter=0;iter<work->numVars;iter++)
+			work->solutions[iter*work->numPoints+point]=solution[iter];
+	}
+	delete[] solution;
+	return NULL;
+}
+
+int sci_sym_sweep(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+	int iRet;
+
+	//data declarations
+	int *varAddress,numVars,numConstr,numIndices,numPoints,numThreads=1,gridCols,rows,cols,iter,threadIter;
+	int *indices=NULL;
+	double *indicesInput,*grid,*objVals=NULL,*solutions=NULL,*statuses=NULL;
+	char *kind=NULL,*rowSense=NULL;
+	double *rowRange=NULL;
+	bool isRHS,failed=false;
+	sweepWork *work;
+	pthread_t *threads;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,3,4) ;
+	CheckOutputArgument(pvApiCtx,1,3) ;
+
+	iRet=sym_get_num_cols(global_sym_env,&numVars);
+	if(iRet!=FUNCTION_TERMINATED_ABNORMALLY)
+		iRet=sym_get_num_rows(global_sym_env,&numConstr);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: what is being swept, "rhs" or "obj"
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &kind) )
+	{
+		Scierror(999, "Wrong type for input argument #1: Either \"rhs\" or \"obj\" is expected.\n");
+		return 1;
+	}
+	if(strcmp(kind,"rhs")==0)
+		isRHS=true;
+	else if(strcmp(kind,"obj")==0)
+		isRHS=false;
+	else{
+		freeAllocatedSingleString(kind);
+		Scierror(999, "Wrong value for input argument #1: Either \"rhs\" or \"obj\" is expected.\n");
+		return 1;
+	}
+	freeAllocatedSingleString(kind);
+
+	//get input 2: indices of the constraints or variables that change along the grid
+	if(getDoubleMatrixFromScilab(2,&rows,&cols,&indicesInput))
+		return 1;
+	numIndices=rows*cols;
+	if(numIndices==0 || (rows!=1 && cols!=1)){
+		Scierror(999, "Wrong size for input argument #2: A vector of indices is expected.\n");
+		return 1;
+	}
+	for(iter=0;iter<numIndices;iter++)
+		if(indicesInput[iter]<0 || indicesInput[iter]>=(isRHS?numConstr:numVars) || indicesInput[iter]!=(int)indicesInput[iter]){
+			Scierror(999, "Wrong value for input argument #2: Entry %d must be a whole number between 0 and %d.\n",iter+1,(isRHS?numConstr:numVars)-1);
+			return 1;
+		}
+
+	//get input 3: the grid, one row per point and one column per index
+	if(getDoubleMatrixFromScilab(3,&numPoints,&gridCols,&grid))
+		return 1;
+	if(gridCols!=numIndices){
+		Scierror(999, "Wrong size for input argument #3: A matrix with %d columns is expected.\n",numIndices);
+		return 1;
+	}
+
+	//get input 4: number of threads
+	if(nbInputArgument(pvApiCtx)==4){
+		if(getUIntFromScilab(4,&numThreads))
+			return 1;
+		if(numThreads<1)
+			numThreads=1;
+	}
+	if(numThreads>numPoints)
+		numThreads=(numPoints>0?numPoints:1);
+
+	indices=new int[numIndices];
+	for(iter=0;iter<numIndices;iter++)
+		indices[iter]=(int)indicesInput[iter];
+	if(isRHS){
+		//the type and range of a constraint are kept, only its right hand side changes
+		rowSense=new char[numConstr];
+		rowRange=new double[numConstr];
+		if(sym_get_row_sense(global_sym_env,rowSense)==FUNCTION_TERMINATED_ABNORMALLY ||
+			sym_get_row_range(global_sym_env,rowRange)==FUNCTION_TERMINATED_ABNORMALLY)
+			failed=true;
+	}
+	objVals=new double[numPoints];
+	solutions=new double[numPoints*numVars];
+	statuses=new double[numPoints];
+	//the points that are not reached when the sweep is stopped are left as NaN
+	for(iter=0;iter<numPoints;iter++)
+		objVals[iter]=statuses[iter]=NAN;
+	for(iter=0;iter<numPoints*numVars;iter++)
+		solutions[iter]=NAN;
+
+	//each thread gets a contiguous range of points, so that consecutive warm starts stay close
+	work=new sweepWork[numThreads];
+	threads=new pthread_t[numThreads];
+	for(threadIter=0;threadIter<numThreads && !failed;threadIter++){
+		work[threadIter].env=sym_create_copy_environment(global_sym_env);
+		if(work[threadIter].env==NULL){
+			failed=true;
+			break;
+		}
+		sym_set_int_param(work[threadIter].env,"keep_warm_start",TRUE);
+		work[threadIter].isRHS=isRHS;
+		work[threadIter].numIndices=numIndices;
+		work[threadIter].indices=indices;
+		work[threadIter].numPoints=numPoints;
+		work[threadIter].firstPoint=(int)((long)numPoints*threadIter/numThreads);
+		work[threadIter].lastPoint=(int)((long)numPoints*(threadIter+1)/numThreads);
+		work[threadIter].numVars=numVars;
+		work[threadIter].grid=grid;
+		work[threadIter].rowSense=rowSense;
+		work[threadIter].rowRange=rowRange;
+		work[threadIter].objVals=objVals;
+		work[threadIter].solutions=solutions;
+		work[threadIter].statuses=statuses;
+		work[threadIter].failed=false;
+	}
+	if(failed)
+		numThreads=threadIter; //only these environments have been created
+	else{
+		//the calling thread works on the first range itself
+		solve_group_begin(-1,NULL);
+		for(threadIter=1;threadIter<numThreads;threadIter++)
+			if(pthread_create(&threads[threadIter],NULL,sweepThread,&work[threadIter])){
+				sweepThread(&work[threadIter]);
+				threads[threadIter]=pthread_self();
+			}
+		sweepThread(&work[0]);
+		for(threadIter=1;threadIter<numThreads;threadIter++)
+			if(!pthread_equal(threads[threadIter],pthread_self()))
+				pthread_join(threads[threadIter],NULL);
+		if(solve_group_end()==SOLVE_INTERRUPTED)
+			sciprint("\nThe sweep was interrupted. The points that were not solved are NaN.\n");
+	}
+	for(threadIter=0;threadIter<numThreads;threadIter++){
+		failed=failed || work[threadIter].failed;
+		sym_close_environment(work[threadIter].env);
+	}
+	delete[] work;
+	delete[] threads;
+	delete[] indices;
+	if(rowSense) delete[] rowSense;
+	if(rowRange) delete[] rowRange;
+
+	if(failed){
+		delete[] objVals;
+		delete[] solutions;
+		delete[] statuses;
+		Scierror(999, "An error occured while setting up the sweep.\n");
+		return 1;
+	}
+	sciprint("\nSolved %d grid points.\n",numPoints);
+
+	//code to give output
+	sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,numPoints,1,objVals);
+	if(!sciErr.iErr && nbOutputArgument(pvApiCtx)>=2)
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+2,numPoints,numVars,solutions);
+	if(!sciErr.iErr && nbOutputArgument(pvApiCtx)>=3)
+		sciErr=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+3,numPoints,1,statuses);
+	delete[] objVals;
+	delete[] solutions;
+	delete[] statuses;
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	for(iter=1;iter<=nbOutputArgument(pvApiCtx) && iter<=3;iter++)
+		AssignOutputVariable(pvApiCtx, iter) = nbInputArgument(pvApiCtx)+iter;
+
+	return 0;
+}
+
+}
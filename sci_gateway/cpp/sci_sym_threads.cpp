@@ -0,0 +1,78 @@
+/*
+ * Symphony Toolbox
+ * Number of threads of the tree search
+ * A Symphony library built with OpenMP processes as many nodes at a time as its "max_active_nodes"
+ * parameter allows, one on each thread; other builds process them one at a time
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include <unistd.h>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+
+//the number of threads used unless sym_setThreads asks for another: one for each processor with OpenMP
+static int threadsDefault()
+{
+#ifdef _OPENMP
+	int processors=sysconf(_SC_NPROCESSORS_ONLN);
+	return (processors>1)?processors:1;
+#else
+	return 1;
+#endif
+}
+
+//give env the default number of threads, to be called when its parameters are set to their defaults
+void threadsSetDefault(sym_environment *env)
+{
+	sym_set_int_param(env,"max_active_nodes",threadsDefault());
+}
+
+int sci_sym_setThreads(char *fname){
+
+	//data declarations
+	double threadsInput;
+	int numThreads=threadsDefault();
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: number of threads, the default if not given
+	if(nbInputArgument(pvApiCtx)==1){
+		if(getDoubleFromScilab(1,&threadsInput))
+			return 1;
+		if(threadsInput<1 || threadsInput!=(int)threadsInput){
+			Scierror(999, "Wrong value for input argument #1: A positive whole number is expected.\n");
+			return 1;
+		}
+		numThreads=(int)threadsInput;
+#ifndef _OPENMP
+		if(numThreads>1){
+			sciprint("Warning: This Symphony library was built without OpenMP, nodes are processed on 1 thread.\n");
+			numThreads=1;
+		}
+#endif
+	}
+	if(sym_set_int_param(global_sym_env,"max_active_nodes",numThreads)==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured while setting the number of threads.\n");
+		return 1;
+	}
+
+	//code to give output: the number of threads now used
+	return returnDoubleToScilab(numThreads);
+}
+
+}
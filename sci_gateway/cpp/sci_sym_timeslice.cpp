@@ -0,0 +1,111 @@
+/*
+ * Symphony Toolbox
+ * Solving the loaded problem a slice of time at a time
+ * The solve is stopped as Ctrl-C stops it and its warm start, which holds the tree, is continued by the next slice
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_progress.hpp"
+#include "sci_sym_timeslice.hpp"
+#include <map>
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <math.h>
+int sliced_solve(sym_environment*,int,double,int*);
+}
+
+//the size of the problem whose tree was left unfinished, a different size means another problem was loaded since
+struct sliceState{
+	int numCols,numRows,numElements;
+};
+
+static std::map<sym_environment*,sliceState> sliceStates;
+
+void timesliceForget(sym_environment *env)
+{
+	sliceStates.erase(env);
+}
+
+static bool getProblemSize(sym_environment *env, sliceState *size)
+{
+	return sym_get_num_cols(env,&size->numCols)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_num_rows(env,&size->numRows)!=FUNCTION_TERMINATED_ABNORMALLY &&
+		sym_get_num_elements(env,&size->numElements)!=FUNCTION_TERMINATED_ABNORMALLY;
+}
+
+extern "C" {
+
+int sci_sym_solveFor(char *fname){
+
+	//data declarations
+	double seconds,results[4]; //status, incumbent, bound, finished
+	int status,warm,keepWarmStart=FALSE,capturing,iter;
+	sliceState size;
+	std::map<sym_environment*,sliceState>::iterator previous;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,4) ;
+
+	if(!getProblemSize(global_sym_env,&size)){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//get input 1: length of the slice in seconds
+	if(getDoubleFromScilab(1,&seconds))
+		return 1;
+	if(seconds<0){
+		Scierror(999, "Wrong value for input argument #1: A non-negative number of seconds is expected.\n");
+		return 1;
+	}
+
+	//continue the tree left by the previous slice, if it was left for the same problem
+	previous=sliceStates.find(global_sym_env);
+	warm=(previous!=sliceStates.end() && previous->second.numCols==size.numCols &&
+		previous->second.numRows==size.numRows && previous->second.numElements==size.numElements);
+	sym_get_int_param(global_sym_env,"keep_warm_start",&keepWarmStart);
+	sym_set_int_param(global_sym_env,"keep_warm_start",TRUE);
+	capturing=progressBegin(global_sym_env);
+	status=sliced_solve(global_sym_env,warm,seconds,NULL);
+	if(capturing)
+		progressEnd();
+	sym_set_int_param(global_sym_env,"keep_warm_start",keepWarmStart);
+
+	//Ctrl-C leaves the tree unfinished too, the next slice continues it
+	if(status==TM_SIGNAL_CAUGHT)
+		sliceStates[global_sym_env]=size;
+	else
+		sliceStates.erase(global_sym_env);
+
+	//code to give output: symphony gives no bound of an unfinished tree, so it is only known once optimal
+	results[0]=status;
+	results[2]=NAN;
+	if(sym_get_obj_val(global_sym_env,&results[1])==FUNCTION_TERMINATED_ABNORMALLY)
+		results[1]=NAN;
+	else if(status==TM_OPTIMAL_SOLUTION_FOUND || status==PREP_OPTIMAL_SOLUTION_FOUND)
+		results[2]=results[1];
+	results[3]=(status!=TM_SIGNAL_CAUGHT);
+	for(iter=0;iter<nbOutputArgument(pvApiCtx) || iter==0;iter++){
+		if(createScalarDouble(pvApiCtx,nbInputArgument(pvApiCtx)+iter+1,results[iter]))
+			return 1;
+		AssignOutputVariable(pvApiCtx,iter+1)=nbInputArgument(pvApiCtx)+iter+1;
+	}
+
+	return 0;
+}
+
+}
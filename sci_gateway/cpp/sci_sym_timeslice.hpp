@@ -0,0 +1,13 @@
+// Symphony Toolbox for Scilab
+// (Declaration of) Functions for solving a problem a slice of time at a time
+// The tree of a solve stopped at the end of its slice is kept in the environment and continued by the next slice
+
+#ifndef SCI_SYMTIMESLICEHEADER
+#define SCI_SYMTIMESLICEHEADER
+
+#include "symphony.h"
+
+//forget the unfinished tree of env, to be called when env is closed
+void timesliceForget(sym_environment *env);
+
+#endif //SCI_SYMTIMESLICEHEADER
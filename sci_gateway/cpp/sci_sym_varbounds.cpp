@@ -5,6 +5,7 @@
  */
 #include "symphony.h"
 #include "sci_iofunc.hpp"
+#include "sci_sym_presolve.hpp"
 
 extern sym_environment* global_sym_env; //defined in globals.cpp
 
@@ -32,6 +33,8 @@ int sci_sym_setVarBound(char *fname){
 		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
 		return 1;
 	}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
 	
 	//code to check arguments and get them
 	CheckInputArgument(pvApiCtx,2,2) ;
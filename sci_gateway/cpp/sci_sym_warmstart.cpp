@@ -0,0 +1,283 @@
+/*
+ * Symphony Toolbox
+ * Functions for capturing, storing and reusing warm starts
+ * Warm starts are kept natively and referred to from Scilab by a handle
+ */
+#include "symphony.h"
+#include "sci_iofunc.hpp"
+#include "sci_sym_progress.hpp"
+#include "sci_sym_checkpoint.hpp"
+
+extern sym_environment* global_sym_env; //defined in globals.cpp
+
+extern "C" {
+#include "api_scilab.h"
+#include "Scierror.h"
+#include "sciprint.h"
+#include "BOOL.h"
+#include <localization.h>
+#include <stdlib.h>
+
+int process_ret_val(int);
+int interruptible_solve(sym_environment*,int);
+
+//table of stored warm starts, a handle is the (1-based) position in this table
+static warm_start_desc **wsTable=NULL;
+static int wsTableSize=0;
+
+//store a warm start in the table and return its handle, 0 on failure
+static int storeWarmStart(warm_start_desc *ws)
+{
+	int iter;
+	warm_start_desc **newTable;
+	for(iter=0;iter<wsTableSize;iter++) //reuse a free slot if there is one
+		if(wsTable[iter]==NULL)
+		{
+			wsTable[iter]=ws;
+			return iter+1;
+		}
+	newTable=(warm_start_desc**)realloc(wsTable,sizeof(warm_start_desc*)*(wsTableSize+8));
+	if(newTable==NULL)
+		return 0;
+	wsTable=newTable;
+	for(iter=wsTableSize;iter<wsTableSize+8;iter++)
+		wsTable[iter]=NULL;
+	wsTable[wsTableSize]=ws;
+	wsTableSize+=8;
+	return wsTableSize-7;
+}
+
+//get input argNum as a handle and return the warm start it refers to, NULL on failure
+static warm_start_desc *getWarmStartFromScilab(int argNum,int *handle)
+{
+	if(getUIntFromScilab(argNum,handle))
+		return NULL;
+	if(*handle<1 || *handle>wsTableSize || wsTable[*handle-1]==NULL)
+	{
+		Scierror(999, "Wrong value for input argument #%d: A valid warm start handle is expected.\n",argNum);
+		return NULL;
+	}
+	return wsTable[*handle-1];
+}
+
+int sci_sym_getWarmStart(char *fname){
+
+	//data declarations
+	warm_start_desc *ws;
+	int handle;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//code to process input
+	ws=sym_get_warm_start(global_sym_env,TRUE);
+	if(ws==NULL){
+		Scierror(999, "No warm start is available. Set the \"keep_warm_start\" parameter to 1 before calling sym_solve().\n");
+		return 1;
+	}
+	handle=storeWarmStart(ws);
+	if(handle==0){
+		sym_delete_warm_start(ws);
+		Scierror(999, "Unable to store the warm start.\n");
+		return 1;
+	}
+
+	//code to give output
+	if(returnDoubleToScilab(handle))
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_setWarmStart(char *fname){
+
+	//error management variable
+	int iRet;
+
+	//data declarations
+	warm_start_desc *ws;
+	int handle;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL){
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+	}
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: handle of the warm start
+	ws=getWarmStartFromScilab(1,&handle);
+	if(ws==NULL)
+		return 1;
+
+	//symphony keeps its own copy, so the stored warm start can be reused
+	iRet=sym_set_warm_start(global_sym_env,ws);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+	}
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_warmSolve(char *fname){
+
+	//data declarations
+	int status=0,capturing;
+
+	//check whether we have no input and one output argument or not
+	CheckInputArgument(pvApiCtx,0,0) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//ensure that environment is active
+	if(global_sym_env==NULL)
+		sciprint("Error: Symphony environment is not initialized.\n");
+	else{
+		capturing=progressBegin(global_sym_env);
+		if(checkpointEnabled())
+			status=checkpointSolve(global_sym_env,1);
+		else
+			status=interruptible_solve(global_sym_env,1);
+		if(capturing)
+			progressEnd();
+		status=process_ret_val(status);
+	}
+
+	//code to give output
+	return returnDoubleToScilab(status);
+}
+
+int sci_sym_saveWarmStart(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+	int iRet;
+
+	//data declarations
+	warm_start_desc *ws;
+	int *varAddress,handle;
+	char *fileName=NULL;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,2,2) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: handle of the warm start
+	ws=getWarmStartFromScilab(1,&handle);
+	if(ws==NULL)
+		return 1;
+
+	//get input 2: name of the file to write
+	sciErr = getVarAddressFromPosition(pvApiCtx, 2, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #2: A file name is expected.\n");
+		return 1;
+	}
+
+	iRet=sym_write_warm_start_desc(ws,fileName);
+	freeAllocatedSingleString(fileName);
+	if(iRet==FUNCTION_TERMINATED_ABNORMALLY){
+		Scierror(999, "An error occured while writing the warm start file.\n");
+		return 1;
+	}
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_loadWarmStart(char *fname){
+
+	//error management variable
+	SciErr sciErr;
+
+	//data declarations
+	warm_start_desc *ws;
+	int *varAddress,handle;
+	char *fileName=NULL;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: name of the file to read
+	sciErr = getVarAddressFromPosition(pvApiCtx, 1, &varAddress);
+	if (sciErr.iErr)
+	{
+		printError(&sciErr, 0);
+		return 1;
+	}
+	if ( !isStringType(pvApiCtx,varAddress) || getAllocatedSingleString(pvApiCtx, varAddress, &fileName) )
+	{
+		Scierror(999, "Wrong type for input argument #1: A file name is expected.\n");
+		return 1;
+	}
+
+	ws=sym_read_warm_start(fileName);
+	freeAllocatedSingleString(fileName);
+	if(ws==NULL){
+		Scierror(999, "An error occured while reading the warm start file.\n");
+		return 1;
+	}
+	handle=storeWarmStart(ws);
+	if(handle==0){
+		sym_delete_warm_start(ws);
+		Scierror(999, "Unable to store the warm start.\n");
+		return 1;
+	}
+
+	//code to give output
+	if(returnDoubleToScilab(handle))
+		return 1;
+
+	return 0;
+}
+
+int sci_sym_deleteWarmStart(char *fname){
+
+	//data declarations
+	warm_start_desc *ws;
+	int handle;
+
+	//code to check arguments and get them
+	CheckInputArgument(pvApiCtx,1,1) ;
+	CheckOutputArgument(pvApiCtx,1,1) ;
+
+	//get input 1: handle of the warm start
+	ws=getWarmStartFromScilab(1,&handle);
+	if(ws==NULL)
+		return 1;
+
+	sym_delete_warm_start(ws);
+	wsTable[handle-1]=NULL;
+
+	//code to give output
+	if(return0toScilab())
+		return 1;
+
+	return 0;
+}
+
+}
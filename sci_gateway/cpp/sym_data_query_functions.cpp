@@ -1,12 +1,13 @@
 /*
  * Implementation Symphony Tool Box for Scilab
  * sym_data_query_functions.cpp
- * contains Data Query Functions( 13 functions)
+ * contains Data Query Functions( 14 functions)
  * Author: Sai Kiran
  */
 
 #include <symphony.h>
 #include <sci_iofunc.hpp>
+#include "sci_sym_presolve.hpp"
 extern sym_environment* global_sym_env;//defined in globals.cpp
 
 extern "C" {
@@ -49,6 +50,8 @@ int sci_sym_get_num_int(char *fname, unsigned long fname_len){
 	
 	if(global_sym_env==NULL) //There is no environment opened.
 		sciprint("Error: Symphony environment is not initialized.\n");
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else {
 		//There is an environment opened
 		int iter=0,length=sizeof(arr_caller)/sizeof(char*),found_at= -1;
@@ -113,8 +116,12 @@ int sci_sym_get_dbl_arr(char *fname, unsigned long fname_len){
 	 * It's length is same as above arrays.
 	*/
 	int matrix_representation[] = { 0 ,0 , 1, 1, 1, 1, 0};
+	SciErr err;
+	int output_position=nbInputArgument(pvApiCtx)+1; //where the empty matrix goes if nothing could be read
 	if(global_sym_env==NULL) //There is no environment opened.
 		sciprint("Error: Symphony environment is not initialized.\n");
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else {
 		//There is an environment opened
 		int iter=0,length=sizeof(arr_caller)/sizeof(char*),found_at= -1;
@@ -125,7 +132,17 @@ int sci_sym_get_dbl_arr(char *fname, unsigned long fname_len){
 		if (found_at != -1){
 			int status1=fun_depends[found_at](global_sym_env,&result_len);
 			if ( status1 == FUNCTION_TERMINATED_NORMALLY && result_len ) {
-				result=(double*)malloc( sizeof(double) * result_len );
+				representation = matrix_representation[found_at];
+				//Allocate the output in scilab's memory, symphony fills it in place
+				if (representation) // output a column-matrix
+					err=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,result_len,1,&result);
+				else // output a row-matrix
+					err=allocMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,result_len,&result);
+				if (err.iErr){ //Process error
+					printError(&err, 0);
+					return 1;
+					}
+				output_position++; //the allocated output cannot be removed, the empty matrix goes after it
 				int ret_val=fun[found_at](global_sym_env,result);
 				show_termination_status(ret_val);
 				if (ret_val == FUNCTION_TERMINATED_ABNORMALLY)
@@ -136,7 +153,9 @@ int sci_sym_get_dbl_arr(char *fname, unsigned long fname_len){
 						if (sense == -1) // Multiply with -1 while showing 
 							for (;iter < result_len;++iter) result[iter] *= -1; 						
 						}
-					representation = matrix_representation[found_at];
+					//assign result position to output argument
+					AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx) + 1;
+					return 0;
 					}				
 				}
 			else
@@ -146,14 +165,8 @@ int sci_sym_get_dbl_arr(char *fname, unsigned long fname_len){
 			sciprint("\nError in function mapping in scilab script\n");
 		}
 
-	//Copy the result to scilab. Location is position next to input arguments.
-	SciErr err;
-	if (representation) // output a column-matrix
-		err=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,result_len,1,result);
-	else // output a row-matrix
-		err=createMatrixOfDouble(pvApiCtx,nbInputArgument(pvApiCtx)+1,1,result_len,result);
-	free(result); //Free the allocated space
-	result=NULL; //Set to NULL
+	//Nothing could be read: an empty matrix is returned
+	err=createMatrixOfDouble(pvApiCtx,output_position,0,0,NULL);
 	if (err.iErr){ //Process error
 		AssignOutputVariable(pvApiCtx, 1) = 0;
         printError(&err, 0);
@@ -161,7 +174,7 @@ int sci_sym_get_dbl_arr(char *fname, unsigned long fname_len){
     	}
 
 	//assign result position to output argument
-	AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx) + 1;
+	AssignOutputVariable(pvApiCtx, 1) = output_position;
 	//ReturnArguments(pvApiCtx);
 	return 0;
 	}
@@ -182,6 +195,8 @@ int sci_sym_get_row_sense(char *fname, unsigned long fname_len) {
 	int num_rows=0;
 	if(global_sym_env==NULL) //There is no environment opened.
 		sciprint("Error: Symphony environment is not initialized.\n");
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else {
 		int status=sym_get_num_rows(global_sym_env,&num_rows);
 		if (status != FUNCTION_TERMINATED_ABNORMALLY) { //If function terminated normally
@@ -273,6 +288,8 @@ int sci_sym_get_matrix(char *fname, unsigned long fname_len){
 
 	if(global_sym_env==NULL) //There is no environment opened.
 		sciprint("Error: Symphony environment is not initialized.\n");
+	else if(presolveCheckIndices(global_sym_env))
+		return 1;
 	else { //There is an environment opened
 		int status1=sym_get_num_elements(global_sym_env,&nz_ele); //No. of non-zero elements
 		int status2=sym_get_num_cols(global_sym_env , &columns); //Columns
@@ -358,24 +375,24 @@ int sci_sym_get_matrix(char *fname, unsigned long fname_len){
 */
 void column_major_to_row_major(int rows,int columns,int nz_ele,double *elements,int *row_indices,int *column_start,double *new_list,int *count_per_row,int *column_position) {
 
-	int iter=0,iter2,iter3=0,index=0;
-	for (iter=0;iter < rows;++iter) {
-		for (iter2=0;iter2 < nz_ele;++iter2) {
-			if (row_indices[iter2] == iter) {
-				count_per_row[iter]++; //Count of non-zero elements per row.
-				new_list[index]=elements[iter2];
-				for (iter3=0; iter3 < columns+1 ; ++iter3) {
-					if (iter2 < column_start[iter3])
-						break;
-					}
-				column_position[index] = iter3 - 1;
-				index++ ;
-				}
+	int iter=0,iter2,index;
+	int *next_in_row=(int*)malloc(sizeof(int) * (rows+1)); //Position in new_list of the next element of each row
+	for (iter2=0;iter2 < nz_ele;++iter2)
+		count_per_row[row_indices[iter2]]++; //Count of non-zero elements per row.
+	next_in_row[0]=0;
+	for (iter=0;iter < rows;++iter)
+		next_in_row[iter+1]=next_in_row[iter]+count_per_row[iter];
+	//Columns are visited in order, so the elements of each row stay sorted by column
+	for (iter=0;iter < columns;++iter) {
+		for (iter2=column_start[iter];iter2 < column_start[iter+1];++iter2) {
+			index=next_in_row[row_indices[iter2]]++;
+			new_list[index]=elements[iter2];
+			column_position[index]=iter;
 			}
 		}
+	free(next_in_row);
 	}
 
-
 /*
  * This function is used to get iteration count after solving a problem
 */
@@ -401,4 +418,133 @@ int sci_sym_get_iteration_count(char *fname, unsigned long fname_len){
 	return returnDoubleToScilab(iteration_count);
 	}
 
+/* Field names of the structure returned by sym_getModel, in the order the fields are written */
+#define NUM_MODEL_FIELDS 13
+static const char *model_field_names[NUM_MODEL_FIELDS]={"numVar","numConstr","objSense","objCoeff",
+	"varLower","varUpper","isInt","conLower","conUpper","conRHS","conRange","conSense","matrix"};
+
+/*
+ * This function returns the whole loaded problem as a structure, in one call.
+ * The arrays are allocated in the structure and filled by symphony in place;
+ * the senses of the constraints are returned as a single string with one character per constraint.
+ */
+int sci_sym_get_model(char *fname, unsigned long fname_len){
+
+	SciErr err;
+	int rows=0,columns=0,nz_ele=0,sense=1,iter,*list_address,dims[2]={1,1},ret_val=FUNCTION_TERMINATED_NORMALLY;
+	const char *field_names[NUM_MODEL_FIELDS+2];
+	double *values,scalar;
+	char is_int;
+
+	//check whether we have no input and one output argument or not
+	CheckInputArgument(pvApiCtx, 0, 0) ; //no input argument
+	CheckOutputArgument(pvApiCtx, 1, 1) ; //one output argument
+
+	if(global_sym_env==NULL){ //There is no environment opened.
+		sciprint("Error: Symphony environment not initialized. Please run 'sym_open()' first.\n");
+		return 1;
+		}
+	if(presolveCheckIndices(global_sym_env))
+		return 1;
+	if (sym_get_num_rows(global_sym_env,&rows) == FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_cols(global_sym_env,&columns) == FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_num_elements(global_sym_env,&nz_ele) == FUNCTION_TERMINATED_ABNORMALLY ||
+		sym_get_obj_sense(global_sym_env,&sense) == FUNCTION_TERMINATED_ABNORMALLY) {
+		Scierror(999, "An error occured. Has a problem been loaded?\n");
+		return 1;
+		}
+
+	/* Arrays of the problem that are returned as they are, with their size and the function that fills them */
+	int (*fill[])(sym_environment*,double*)= {sym_get_obj_coeff,sym_get_col_lower,sym_get_col_upper,NULL,
+											sym_get_row_lower,sym_get_row_upper,sym_get_rhs,sym_get_row_range};
+	int fill_rows[]={1,1,1,1,rows,rows,rows,rows},fill_columns[]={columns,columns,columns,columns,1,1,1,1};
+
+	//The structure is an mlist of type "st"
+	field_names[0]="st";
+	field_names[1]="dims";
+	for (iter=0;iter < NUM_MODEL_FIELDS;++iter)
+		field_names[iter+2]=model_field_names[iter];
+	err=createMList(pvApiCtx,nbInputArgument(pvApiCtx)+1,NUM_MODEL_FIELDS+2,&list_address);
+	if (!err.iErr)
+		err=createMatrixOfStringInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,1,1,NUM_MODEL_FIELDS+2,field_names);
+	if (!err.iErr)
+		err=createMatrixOfInteger32InList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,2,1,2,dims);
+	scalar=columns;
+	if (!err.iErr)
+		err=createMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,3,1,1,&scalar);
+	scalar=rows;
+	if (!err.iErr)
+		err=createMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,4,1,1,&scalar);
+	scalar=sense;
+	if (!err.iErr)
+		err=createMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,5,1,1,&scalar);
+	for (iter=0;iter < 8 && !err.iErr;++iter) {
+		if (fill[iter] == NULL) { //isInt, a boolean row written below
+			int *bools=(int*)malloc(sizeof(int) * (columns+1));
+			int iter2=0;
+			for (;iter2 < columns;++iter2) {
+				sym_is_integer(global_sym_env,iter2,&is_int);
+				bools[iter2]=is_int?1:0;
+				}
+			err=createMatrixOfBooleanInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,iter+6,1,columns,bools);
+			free(bools);
+			continue;
+			}
+		err=allocMatrixOfDoubleInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,iter+6,fill_rows[iter],fill_columns[iter],&values);
+		if (!err.iErr && fill_rows[iter]*fill_columns[iter]>0 && fill[iter](global_sym_env,values) == FUNCTION_TERMINATED_ABNORMALLY)
+			ret_val=FUNCTION_TERMINATED_ABNORMALLY;
+		if (!err.iErr && iter == 0 && sense == -1) { // Multiply with -1 while showing, as sym_getObjCoeff does
+			int iter2=0;
+			for (;iter2 < columns;++iter2) values[iter2] *= -1;
+			}
+		}
+
+	//conSense: one character per constraint
+	if (!err.iErr) {
+		char *senses=(char*)malloc(sizeof(char) * (rows+1));
+		if (rows && sym_get_row_sense(global_sym_env,senses) == FUNCTION_TERMINATED_ABNORMALLY)
+			ret_val=FUNCTION_TERMINATED_ABNORMALLY;
+		senses[rows]='\0';
+		err=createMatrixOfStringInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,NUM_MODEL_FIELDS+1,1,1,&senses);
+		free(senses);
+		}
+
+	//matrix: converted from the column-major form of symphony to the row-major form of scilab
+	if (!err.iErr) {
+		int *column_start=(int*)malloc(sizeof(int) * (columns+1));
+		int *row_indices=(int*)malloc(sizeof(int) * (nz_ele+1));
+		double *elements=(double*)malloc(sizeof(double) * (nz_ele+1));
+		double *new_list=(double*)calloc(nz_ele+1,sizeof(double));
+		int *count_per_row=(int*)calloc(rows+1,sizeof(int));
+		int *column_position=(int*)calloc(nz_ele+1,sizeof(int));
+		if (sym_get_matrix(global_sym_env,&nz_ele,column_start,row_indices,elements) == FUNCTION_TERMINATED_ABNORMALLY)
+			ret_val=FUNCTION_TERMINATED_ABNORMALLY;
+		else {
+			column_major_to_row_major(rows,columns,nz_ele,elements,row_indices,column_start,new_list,count_per_row,column_position);
+			for (iter=0;iter < nz_ele;++iter) column_position[iter]++; //Scilab counts columns from 1
+			err=createSparseMatrixInList(pvApiCtx,nbInputArgument(pvApiCtx)+1,list_address,NUM_MODEL_FIELDS+2,rows,columns,nz_ele,
+				count_per_row,column_position,new_list);
+			}
+		free(column_start);
+		free(row_indices);
+		free(elements);
+		free(new_list);
+		free(count_per_row);
+		free(column_position);
+		}
+
+	if (err.iErr){ //Process error
+		printError(&err, 0);
+		return 1;
+		}
+	if (ret_val == FUNCTION_TERMINATED_ABNORMALLY) {
+		Scierror(999, "An error occured while getting the problem from Symphony.\n");
+		return 1;
+		}
+
+	//assign result position to output argument
+	AssignOutputVariable(pvApiCtx, 1) = nbInputArgument(pvApiCtx) + 1;
+	return 0;
+	}
+
 }
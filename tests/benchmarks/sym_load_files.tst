@@ -0,0 +1,83 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- BENCH NB RUN : 1 -->
+
+// Reading the same large problem with each of the readers, best time of nbRun reads
+// A random problem with 20000 constraints, 50000 variables and 10 nonzeros per column is written first
+
+nbCon = 20000;
+nbVar = 50000;
+nzPerVar = 10;
+nbRun = 5;
+fileName = TMPDIR + "/bench_loadmps.mps";
+if ~isfile(fileName) then
+    rand("seed", 0);
+    lines = ["NAME          BENCH"; "ROWS"; " N  obj"];
+    lines = [lines; " L  c" + string(1:nbCon)'];
+    lines = [lines; "COLUMNS"];
+    col = " x" + string(1:nbVar)';
+    // every column takes the same distinct offsets from its own first row, so no row appears twice in a column
+    [tmp, offsets] = gsort(rand(1, nbCon));
+    offsets = offsets(1:nzPerVar) - 1;
+    first = floor(rand(nbVar, 1) * nbCon);
+    cols = [];
+    for k = 1:nzPerVar
+        rows = modulo(first + offsets(k), nbCon) + 1;
+        cols = [cols, col + "  c" + string(rows) + "  " + string(round(rand(nbVar,1)*100)/10)];
+    end
+    cols = [col + "  obj  " + string(-round(rand(nbVar,1)*100)/10), cols];
+    lines = [lines; matrix(cols', -1, 1)];
+    lines = [lines; "RHS"; "    RHS  c" + string(1:nbCon)' + "  " + string(round(rand(nbCon,1)*1000))];
+    lines = [lines; "BOUNDS"; " UP BND  x" + string(1:nbVar)' + "  10"; "ENDATA"];
+    mputl(lines, fileName);
+end
+
+sym_open();
+sym_setIntParam("verbosity", -2);
+// the LP format file is the same problem written by sym_saveLP
+lpFileName = TMPDIR + "/bench_loadmps.lp";
+if ~isfile(lpFileName) then
+    sym_loadMPSFast(fileName);
+    sym_saveLP(lpFileName);
+end
+// and the model file is the same problem written by sym_saveModel
+modelFileName = TMPDIR + "/bench_loadmps.symmodel";
+if ~isfile(modelFileName) then
+    sym_loadMPSFast(fileName);
+    sym_saveModel(modelFileName);
+end
+
+// each reader is given as the call that loads the file and the file it reads
+readers = ["sym_loadMPS(fileName)", fileName;
+           "sym_loadMPSFast(fileName, 1)", fileName;
+           "sym_loadMPSFast(fileName)", fileName;
+           "sym_loadLP(lpFileName)", lpFileName;
+           "sym_loadModel(modelFileName)", modelFileName];
+
+// <-- BENCH START -->
+times = %inf * ones(size(readers, "r"), 1);
+for r = 1:size(readers, "r")
+    for k = 1:nbRun
+        tic();
+        execstr(readers(r, 1));
+        times(r) = min(times(r), toc());
+    end
+end
+// <-- BENCH END -->
+
+mprintf("\n %-30s %10s %8s %9s\n", "reader", "time (s)", "MB/s", "speedup");
+for r = 1:size(readers, "r")
+    info = fileinfo(readers(r, 2));
+    mprintf(" %-30s %10.3f %8.1f %9.2f\n", readers(r, 1), times(r), info(1) / 1e6 / times(r), times(1) / times(r));
+end
+
+sym_close();
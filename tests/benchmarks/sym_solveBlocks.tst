@@ -0,0 +1,67 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- BENCH NB RUN : 1 -->
+
+// Solving independent plant scheduling problems as one tree and block by block, best time of nbRun solves
+// Each plant has its own machines and jobs, no constraint links two plants
+
+rand("seed", 0);
+nbPlant = 8;
+nbJob = 15;
+nbMachine = 3;
+nbVarPlant = nbJob * nbMachine;
+nbConPlant = nbJob + nbMachine;
+A = spzeros(nbPlant * nbConPlant, nbPlant * nbVarPlant);
+conLB = [];
+conUB = [];
+for p = 1:nbPlant
+    duration = round(rand(nbJob, nbMachine) * 20) + 5;
+    // in each plant, variable (j, m) is at index j + (m - 1) * nbJob
+    capacity = spzeros(nbMachine, nbVarPlant);
+    for m = 1:nbMachine
+        capacity(m, (m - 1) * nbJob + (1:nbJob)) = duration(:, m)';
+    end
+    A((p - 1) * nbConPlant + (1:nbConPlant), (p - 1) * nbVarPlant + (1:nbVarPlant)) = [sparse(repmat(eye(nbJob, nbJob), 1, nbMachine)); capacity];
+    conLB = [conLB; ones(nbJob, 1); -%inf * ones(nbMachine, 1)];
+    conUB = [conUB; ones(nbJob, 1); ceil(sum(duration, "r") / nbMachine * 1.2)'];
+end
+nbVar = nbPlant * nbVarPlant;
+c = round(rand(1, nbVar) * 50) + 5;
+lb = zeros(1, nbVar);
+ub = ones(1, nbVar);
+isInt = repmat(%t, 1, nbVar);
+
+nbRun = 5;
+
+sym_open();
+sym_setIntParam("verbosity", -2);
+solvers = ["sym_solve()"; "sym_solveBlocks()"];
+
+// <-- BENCH START -->
+times = %inf * ones(solvers);
+for s = 1:size(solvers, "*")
+    for k = 1:nbRun
+        sym_loadProblem(nbVar, nbPlant * nbConPlant, lb, ub, c, isInt, 1, A, conLB, conUB);
+        tic();
+        execstr(solvers(s));
+        x = sym_getVarSoln();
+        times(s) = min(times(s), toc());
+    end
+end
+// <-- BENCH END -->
+
+mprintf("\n %-18s %10s %9s\n", "solver", "time (s)", "speedup");
+for s = 1:size(solvers, "*")
+    mprintf(" %-18s %10.3f %9.2f\n", solvers(s), times(s), times(1) / times(s));
+end
+
+sym_close();
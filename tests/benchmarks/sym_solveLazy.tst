@@ -0,0 +1,97 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- BENCH NB RUN : 1 -->
+
+// Solving a travelling salesman problem with subtour elimination constraints added by a loop in Scilab,
+// and added as they are violated inside sym_solveLazy, best time of nbRun solves
+
+rand("seed", 0);
+nbNode = 14;
+points = rand(nbNode, 2) * 100;
+// one variable for each edge (i, j) with i < j, the nodes are numbered from 0
+tails = [];
+heads = [];
+for i = 1:nbNode - 1
+    tails = [tails, (i - 1) * ones(1, nbNode - i)];
+    heads = [heads, i:nbNode - 1];
+end
+nbVar = size(tails, "*");
+c = round(sqrt(sum((points(tails + 1, :) - points(heads + 1, :)) .^ 2, "c")))';
+// each node is on two edges of the tour
+A = spzeros(nbNode, nbVar);
+for e = 1:nbVar
+    A(tails(e) + 1, e) = 1;
+    A(heads(e) + 1, e) = 1;
+end
+lb = zeros(1, nbVar);
+ub = ones(1, nbVar);
+isInt = repmat(%t, 1, nbVar);
+
+nbRun = 5;
+
+// adds the subtours of the solution as constraints and solves again from scratch, until the tour is whole
+function x = subtourLoop(nbNode, nbVar, tails, heads)
+    while %t
+        sym_solve();
+        x = sym_getVarSoln();
+        // label each node with the smallest node of its subtour
+        label = 1:nbNode;
+        chosen = find(x > 0.5);
+        changed = %t;
+        while changed
+            changed = %f;
+            for e = chosen
+                m = min(label(tails(e) + 1), label(heads(e) + 1));
+                if label(tails(e) + 1) <> m | label(heads(e) + 1) <> m then
+                    label([tails(e), heads(e)] + 1) = m;
+                    changed = %t;
+                end
+            end
+        end
+        subtours = unique(label);
+        if size(subtours, "*") == 1 then
+            break;
+        end
+        for s = subtours
+            inS = (label == s);
+            row = spzeros(1, nbVar);
+            row(find(inS(tails + 1) & inS(heads + 1))) = 1;
+            sym_addConstrs(row, -%inf, sum(inS) - 1);
+        end
+    end
+endfunction
+
+sym_open();
+sym_setIntParam("verbosity", -2);
+solvers = ["x = subtourLoop(nbNode, nbVar, tails, heads);";
+           "sym_setSubtourSeparator(0:nbVar - 1, tails, heads); sym_solveLazy(); x = sym_getVarSoln();"];
+names = ["Scilab loop"; "sym_solveLazy"];
+
+// <-- BENCH START -->
+times = %inf * ones(solvers);
+for s = 1:size(solvers, "*")
+    for k = 1:nbRun
+        // the subtour constraints stay in the problem, so each run loads it again
+        sym_loadProblem(nbVar, nbNode, lb, ub, c, isInt, 1, A, 2 * ones(nbNode, 1), 2 * ones(nbNode, 1));
+        tic();
+        execstr(solvers(s));
+        times(s) = min(times(s), toc());
+    end
+end
+// <-- BENCH END -->
+
+mprintf("\n %-14s %10s %9s\n", "solver", "time (s)", "speedup");
+for s = 1:size(solvers, "*")
+    mprintf(" %-14s %10.3f %9.2f\n", names(s), times(s), times(1) / times(s));
+end
+
+sym_close();
@@ -0,0 +1,63 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- BENCH NB RUN : 1 -->
+
+// Solving a scheduling problem with and without the heuristics run first, best time of nbRun solves
+// Each job is assigned to one machine, within the capacity of the machines, at the least cost
+
+rand("seed", 0);
+nbJob = 40;
+nbMachine = 6;
+nbVar = nbJob * nbMachine;
+duration = round(rand(nbJob, nbMachine) * 20) + 5;
+cost = round(rand(nbJob, nbMachine) * 50) + duration;
+// variable (j, m) is at index j + (m - 1) * nbJob
+assign = sparse(repmat(eye(nbJob, nbJob), 1, nbMachine));
+capacity = spzeros(nbMachine, nbVar);
+for m = 1:nbMachine
+    capacity(m, (m - 1) * nbJob + (1:nbJob)) = duration(:, m)';
+end
+A = [assign; capacity];
+conLB = [ones(nbJob, 1); -%inf * ones(nbMachine, 1)];
+conUB = [ones(nbJob, 1); ceil(sum(duration, "r") / nbMachine * 1.2)'];
+c = cost(:)';
+lb = zeros(1, nbVar);
+ub = ones(1, nbVar);
+isInt = repmat(%t, 1, nbVar);
+
+nbRun = 5;
+
+sym_open();
+sym_setIntParam("verbosity", -2);
+heuristics = [0, 1];
+
+// <-- BENCH START -->
+times = %inf * ones(heuristics);
+for h = 1:size(heuristics, "*")
+    sym_setHeuristics(heuristics(h));
+    for k = 1:nbRun
+        // loaded again so that no solve starts from the incumbent of the one before
+        sym_loadProblem(nbVar, nbJob + nbMachine, lb, ub, c, isInt, 1, A, conLB, conUB);
+        tic();
+        sym_solve();
+        times(h) = min(times(h), toc());
+    end
+end
+// <-- BENCH END -->
+
+mprintf("\n heuristics   time (s)   speedup\n");
+for h = 1:size(heuristics, "*")
+    mprintf("%11d %10.3f %9.2f\n", heuristics(h), times(h), times(1) / times(h));
+end
+
+sym_setHeuristics(0);
+sym_close();
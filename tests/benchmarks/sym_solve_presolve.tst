@@ -0,0 +1,58 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- BENCH NB RUN : 1 -->
+
+// Solving a problem with and without presolve, best time of nbRun solves
+// The problem has fixed variables, singleton rows and duplicate columns for presolve to remove
+
+rand("seed", 0);
+nbVar = 400;
+nbCon = 150;
+A = sparse(round(rand(nbCon, nbVar) .* (rand(nbCon, nbVar) < 0.05) * 20));
+A = [A; sparse([(1:50)', (1:50)'], ones(50,1), [50, nbVar])];
+A(:, 301:350) = A(:, 251:300);
+conLB = -%inf * ones(nbCon + 50, 1);
+conUB = [round(rand(nbCon, 1) * 200) + 50; 3 * ones(50, 1)];
+c = -round(rand(1, nbVar) * 50);
+lb = zeros(1, nbVar);
+ub = 10 * ones(1, nbVar);
+ub(351:380) = 0;
+isInt = [repmat(%t, 1, 200) repmat(%f, 1, 200)];
+
+nbRun = 5;
+
+sym_open();
+sym_setIntParam("verbosity", -2);
+presolve = [0, 1];
+
+// <-- BENCH START -->
+times = %inf * ones(presolve);
+for p = 1:size(presolve, "*")
+    sym_setPresolve(presolve(p));
+    for k = 1:nbRun
+        // presolve runs in the loader and postsolve in the getters, so both are timed with the solve
+        tic();
+        sym_loadProblem(nbVar, nbCon + 50, lb, ub, c, isInt, 1, A, conLB, conUB);
+        sym_solve();
+        x = sym_getVarSoln();
+        times(p) = min(times(p), toc());
+    end
+end
+// <-- BENCH END -->
+
+mprintf("\n presolve   time (s)   speedup\n");
+for p = 1:size(presolve, "*")
+    mprintf("%9d %10.3f %9.2f\n", presolve(p), times(p), times(1) / times(p));
+end
+
+sym_setPresolve(0);
+sym_close();
@@ -0,0 +1,56 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- BENCH NB RUN : 1 -->
+
+// Speedup of the tree search with the number of threads, on a fixed set of assignment problems
+// Symphony must be built with OpenMP for more than one thread to be used, see sym_setThreads
+
+nbJob = 30;
+nbMachine = 5;
+nbVar = nbJob * nbMachine;
+nbInstance = 4;
+sym_open();
+sym_setIntParam("verbosity", -2);
+maxThreads = sym_setThreads();
+threadCounts = unique([1, 2 .^ (1:floor(log2(maxThreads))), maxThreads]);
+
+// <-- BENCH START -->
+times = zeros(nbInstance, size(threadCounts, "*"));
+for k = 1:nbInstance
+    // the same problems are solved with each number of threads
+    rand("seed", k);
+    duration = round(rand(nbJob, nbMachine) * 20) + 5;
+    capacity = spzeros(nbMachine, nbVar);
+    for m = 1:nbMachine
+        capacity(m, (m - 1) * nbJob + (1:nbJob)) = duration(:, m)';
+    end
+    A = [sparse(repmat(eye(nbJob, nbJob), 1, nbMachine)); capacity];
+    conLB = [ones(nbJob, 1); -%inf * ones(nbMachine, 1)];
+    conUB = [ones(nbJob, 1); ceil(sum(duration, "r") / nbMachine * 1.2)'];
+    c = round(rand(1, nbVar) * 50) + 5;
+    sym_loadProblem(nbVar, nbJob + nbMachine, zeros(1, nbVar), ones(1, nbVar), c, repmat(%t, 1, nbVar), 1, A, conLB, conUB);
+    for t = 1:size(threadCounts, "*")
+        sym_setThreads(threadCounts(t));
+        tic();
+        sym_solve();
+        times(k, t) = toc();
+    end
+end
+// <-- BENCH END -->
+
+total = sum(times, "r");
+mprintf("\n threads   time (s)   speedup\n");
+for t = 1:size(threadCounts, "*")
+    mprintf("%8d %10.2f %9.2f\n", threadCounts(t), total(t), total(1) / total(t));
+end
+
+sym_close();
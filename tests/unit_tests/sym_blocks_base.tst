@@ -0,0 +1,117 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// Two independent blocks: min 2*x1 + 3*x2 + 4*x3 + x4
+c = [2 3 4 1];
+
+// Bounds of variables
+lb = [0 0 0 0];
+ub = [10 10 10 10];
+
+// Constraint Matrix, with conLB <= A*x <= conUB
+A = [1 1 0 0;
+     0 0 1 2];
+conlb = [3.5; 5];
+conub = [%inf; %inf];
+
+// All the variables are integers
+isInt = [%t %t %t %t];
+
+sym_open();
+sym_loadProblem(4,2,lb,ub,c,isInt,1,sparse(A),conlb,conub);
+
+[numBlocks, varBlock, constrBlock] = sym_getBlocks();
+assert_checkequal( numBlocks , 2 );
+assert_checkequal( varBlock(1) , varBlock(2) );
+assert_checkequal( varBlock(3) , varBlock(4) );
+assert_checktrue( varBlock(1) <> varBlock(3) );
+
+sym_solve();
+f0 = sym_getObjVal();
+x0 = sym_getVarSoln();
+assert_close ( f0 , 11 , 1.e-7 );
+assert_close ( x0 , [4 0 0 3] , 1.e-7 );
+
+// Solving the blocks one by one gives the same optimum
+status = sym_solveBlocks(2);
+assert_checkequal( status , 0 );
+assert_close ( sym_getObjVal() , f0 , 1.e-7 );
+assert_close ( sym_getVarSoln() , x0 , 1.e-7 );
+
+sym_close();
+
+// A maximization with two blocks: max 5*x1 + 4*x2 + 3*x3 + 2*x4 + x5, the optimum is 34
+c = [5 4 3 2 1];
+lb = [0 0 0 0 0];
+ub = [10 10 10 10 2];
+A = [6 4 0 0 0;
+     1 2 0 0 0;
+     0 0 1 1 0];
+conlb = [-%inf; -%inf; -%inf];
+conub = [24; 6; 4.5];
+isInt = [%t %t %t %t %t];
+
+sym_open();
+sym_loadProblem(5,3,lb,ub,c,isInt,-1,sparse(A),conlb,conub);
+sym_solve();
+f0 = sym_getObjVal();
+x0 = sym_getVarSoln();
+assert_close ( f0 , 34 , 1.e-7 );
+assert_close ( x0 , [4 0 4 0 2] , 1.e-7 );
+
+// Each block is maximized too
+status = sym_solveBlocks(2);
+assert_checkequal( status , 0 );
+assert_close ( sym_getObjVal() , f0 , 1.e-7 );
+assert_close ( sym_getVarSoln() , x0 , 1.e-7 );
+
+sym_close();
@@ -0,0 +1,133 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// Objective function, to be minimized
+c = [-5 -4 -3];
+
+// Bounds of variables
+lb = [0 0 0];
+ub = [10 10 10];
+
+// Constraint Matrix, with conLB <= A*x <= conUB
+A = [2 3 1;
+     4 1 2;
+     3 4 2];
+conlb = [-%inf; -%inf; -%inf];
+conub = [5; 11; 8];
+
+// All the variables are integers
+isInt = [%t %t %t];
+
+// Solving without the heuristics
+sym_open();
+sym_loadProblemBasic(3,3,lb,ub,c,isInt,1,A,conlb,conub);
+sym_setHeuristics(0);
+sym_solve();
+f0 = sym_getObjVal();
+assert_close ( f0 , -13 , 1.e-7 );
+
+// The solution of the heuristics is feasible and no better than the optimum
+[fh,xh] = sym_runHeuristics(5);
+assert_checkequal( size(xh,"*") , 3 );
+assert_checktrue( and(xh >= lb - 1.e-7) & and(xh <= ub + 1.e-7) );
+assert_close ( xh , round(xh) , 1.e-7 );
+assert_checktrue( and(A*xh(:) <= conub + 1.e-7) );
+assert_close ( fh , c*xh(:) , 1.e-7 );
+assert_checktrue( fh >= f0 - 1.e-7 );
+
+// Solving with the heuristics gives the same optimum
+sym_loadProblemBasic(3,3,lb,ub,c,isInt,1,A,conlb,conub);
+sym_setHeuristics(1);
+sym_solve();
+f1 = sym_getObjVal();
+x1 = sym_getVarSoln();
+sym_setHeuristics(0);
+sym_close();
+
+assert_close ( f1 , f0 , 1.e-7 );
+assert_checktrue( and(A*x1(:) <= conub + 1.e-7) );
+
+// The heuristics maximize too: max 5*x1 + 4*x2 + 3*x3 + 2*x4 + x5, the optimum is 34
+c = [5 4 3 2 1];
+lb = [0 0 0 0 0];
+ub = [10 10 10 10 2];
+A = [6 4 0 0 0;
+     1 2 0 0 0;
+     0 0 1 1 0];
+conlb = [-%inf; -%inf; -%inf];
+conub = [24; 6; 4.5];
+isInt = [%t %t %t %t %t];
+
+sym_open();
+sym_loadProblem(5,3,lb,ub,c,isInt,-1,sparse(A),conlb,conub);
+sym_setHeuristics(0);
+sym_solve();
+f0 = sym_getObjVal();
+assert_close ( f0 , 34 , 1.e-7 );
+
+// Their solution is feasible and no better than the optimum
+[fh,xh] = sym_runHeuristics(5);
+assert_checkequal( size(xh,"*") , 5 );
+assert_checktrue( and(xh >= lb - 1.e-7) & and(xh <= ub + 1.e-7) );
+assert_checktrue( and(A*xh(:) <= conub + 1.e-7) );
+assert_close ( fh , c*xh(:) , 1.e-7 );
+assert_checktrue( fh <= f0 + 1.e-7 );
+
+// Solving with the heuristics gives the same optimum
+sym_loadProblem(5,3,lb,ub,c,isInt,-1,sparse(A),conlb,conub);
+sym_setHeuristics(1);
+sym_solve();
+f1 = sym_getObjVal();
+sym_setHeuristics(0);
+sym_close();
+
+assert_close ( f1 , f0 , 1.e-7 );
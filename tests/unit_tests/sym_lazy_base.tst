@@ -0,0 +1,141 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// The edges of a complete graph on nbNodes nodes in clusters of three nodes:
+// the edges inside a cluster cost 1 and the others 10
+function [tails, heads, c, A] = cluster_graph ( nbNodes )
+  tails = [];
+  heads = [];
+  c = [];
+  for i = 0:nbNodes-2
+    for j = i+1:nbNodes-1
+      tails = [tails i];
+      heads = [heads j];
+      if floor(i/3) == floor(j/3) then
+        c = [c 1];
+      else
+        c = [c 10];
+      end
+    end
+  end
+  // Each node has two edges
+  A = zeros(nbNodes,size(c,"*"));
+  for e = 1:size(c,"*")
+    A(tails(e)+1,e) = 1;
+    A(heads(e)+1,e) = 1;
+  end
+endfunction
+
+// Checks that the chosen edges make a single tour through all the nodes
+function check_tour ( x, tails, heads, A, nbNodes )
+  assert_checkequal( A*x(:) , 2*ones(nbNodes,1) );
+  used = find(x > 0.5);
+  previous = -1;
+  current = 0;
+  for step = 1:nbNodes
+    next = -1;
+    for e = used
+      if tails(e) == current & heads(e) <> previous then
+        next = heads(e);
+      elseif heads(e) == current & tails(e) <> previous then
+        next = tails(e);
+      end
+    end
+    previous = current;
+    current = next;
+    if current == 0 then
+      break;
+    end
+  end
+  assert_checkequal( current , 0 );
+  assert_checkequal( step , nbNodes );
+endfunction
+
+// Two clusters: without subtour elimination the optimum is two triangles of cost 6
+nbNodes = 6;
+[tails, heads, c, A] = cluster_graph(nbNodes);
+nbEdges = size(c,"*");
+
+sym_open();
+sym_loadProblem(nbEdges,nbNodes,zeros(1,nbEdges),ones(1,nbEdges),c,repmat(%t,1,nbEdges),1,sparse(A),2*ones(nbNodes,1),2*ones(nbNodes,1));
+sym_setSubtourSeparator(0:nbEdges-1,tails,heads);
+[status, numAdded] = sym_solveLazy();
+x = round(sym_getVarSoln());
+f = sym_getObjVal();
+sym_close();
+
+assert_checktrue( numAdded >= 1 );
+assert_close ( f , 24 , 1.e-7 );
+check_tour ( x, tails, heads, A, nbNodes );
+
+// Three clusters, where 2*(x01 + x02 + x12) <= 5 forbids the first triangle: the LP relaxation is
+// fractional, so the first solve finds its solution, a subtour, by branching. The optimum is 36.
+nbNodes = 9;
+[tails, heads, c, A] = cluster_graph(nbNodes);
+nbEdges = size(c,"*");
+side = zeros(1,nbEdges);
+side(find(tails == 0 & heads == 1)) = 2;
+side(find(tails == 0 & heads == 2)) = 2;
+side(find(tails == 1 & heads == 2)) = 2;
+
+sym_open();
+sym_loadProblem(nbEdges,nbNodes+1,zeros(1,nbEdges),ones(1,nbEdges),c,repmat(%t,1,nbEdges),1,sparse([A; side]),[2*ones(nbNodes,1); -%inf],[2*ones(nbNodes,1); 5]);
+sym_setSubtourSeparator(0:nbEdges-1,tails,heads);
+[status, numAdded] = sym_solveLazy();
+x = round(sym_getVarSoln());
+f = sym_getObjVal();
+sym_close();
+
+assert_checktrue( numAdded >= 1 );
+assert_close ( f , 36 , 1.e-7 );
+assert_checktrue( side*x(:) <= 5 );
+check_tour ( x, tails, heads, A, nbNodes );
@@ -0,0 +1,120 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// Infinite values may be given as Symphony's infinity, they are compared as %inf
+function v = with_inf ( v )
+  v(v >= 1.e20) = %inf;
+  v(v <= -1.e20) = -%inf;
+endfunction
+
+// Checks that two models given by sym_getModel hold the same problem
+function check_same_model ( computed, expected )
+  assert_checkequal( computed.numVar , expected.numVar );
+  assert_checkequal( computed.numConstr , expected.numConstr );
+  assert_checkequal( computed.objSense , expected.objSense );
+  assert_checkequal( computed.isInt , expected.isInt );
+  assert_close ( computed.objCoeff , expected.objCoeff , 1.e-12 );
+  assert_checkequal( with_inf(computed.varLower) , with_inf(expected.varLower) );
+  assert_checkequal( with_inf(computed.varUpper) , with_inf(expected.varUpper) );
+  assert_checkequal( with_inf(computed.conLower) , with_inf(expected.conLower) );
+  assert_checkequal( with_inf(computed.conUpper) , with_inf(expected.conUpper) );
+  assert_close ( full(computed.matrix) , full(expected.matrix) , 1.e-12 );
+endfunction
+
+// min x1 + 2*x2 - x3 with x1 integer, the optimum is x = [1 -1 6]
+c = [1 2 -1];
+lb = [0 -1 0];
+ub = [4 1 %inf];
+A = [1 1 0;
+     1 0 0;
+     0 -1 1];
+conlb = [-%inf; 1; 7];
+conub = [4; %inf; 7];
+isInt = [%t %f %f];
+
+// max 5*x1 + 4*x2 + 3*x3 + 2*x4 + x5, the optimum is 34 at x = [4 0 4 0 2]
+cmax = [5 4 3 2 1];
+lbmax = [0 0 0 0 0];
+ubmax = [10 10 10 10 2];
+Amax = [6 4 0 0 0;
+        1 2 0 0 0;
+        0 0 1 1 0];
+conlbmax = [-%inf; -%inf; -%inf];
+conubmax = [24; 6; 4.5];
+isIntmax = [%t %t %t %t %t];
+
+sym_open();
+
+// A problem written with sym_saveLP is read back by sym_loadLP
+lpFile = TMPDIR + "/testmip.lp";
+sym_loadProblem(3,3,lb,ub,c,isInt,1,sparse(A),conlb,conub);
+expected = sym_getModel();
+sym_saveLP(lpFile);
+sym_loadLP(lpFile);
+check_same_model ( sym_getModel() , expected );
+sym_solve();
+assert_close ( sym_getObjVal() , -7 , 1.e-7 );
+assert_close ( sym_getVarSoln() , [1 -1 6] , 1.e-7 );
+
+// A maximization is written as the minimization of the negated objective
+sym_loadProblem(5,3,lbmax,ubmax,cmax,isIntmax,-1,sparse(Amax),conlbmax,conubmax);
+sym_saveLP(lpFile);
+sym_loadLP(lpFile);
+model = sym_getModel();
+assert_checkequal( model.objSense , 1 );
+assert_close ( model.objCoeff , -cmax , 1.e-12 );
+sym_solve();
+assert_close ( sym_getObjVal() , -34 , 1.e-7 );
+assert_close ( sym_getVarSoln() , [4 0 4 0 2] , 1.e-7 );
+
+sym_close();
+deletefile(lpFile);
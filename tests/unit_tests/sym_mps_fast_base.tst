@@ -0,0 +1,119 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// Infinite values may be given as Symphony's infinity, they are compared as %inf
+function v = with_inf ( v )
+  v(v >= 1.e20) = %inf;
+  v(v <= -1.e20) = -%inf;
+endfunction
+
+// Checks that two models given by sym_getModel hold the same problem
+function check_same_model ( computed, expected )
+  assert_checkequal( computed.numVar , expected.numVar );
+  assert_checkequal( computed.numConstr , expected.numConstr );
+  assert_checkequal( computed.objSense , expected.objSense );
+  assert_checkequal( computed.isInt , expected.isInt );
+  assert_close ( computed.objCoeff , expected.objCoeff , 1.e-12 );
+  assert_checkequal( with_inf(computed.varLower) , with_inf(expected.varLower) );
+  assert_checkequal( with_inf(computed.varUpper) , with_inf(expected.varUpper) );
+  assert_checkequal( with_inf(computed.conLower) , with_inf(expected.conLower) );
+  assert_checkequal( with_inf(computed.conUpper) , with_inf(expected.conUpper) );
+  assert_close ( full(computed.matrix) , full(expected.matrix) , 1.e-12 );
+endfunction
+
+// min x1 + 2*x2 - x3 with x1 integer, the optimum is x = [1 -1 6]
+mps = ["NAME          TESTMIP"
+       "ROWS"
+       " N  COST"
+       " L  LIM1"
+       " G  LIM2"
+       " E  MYEQN"
+       "COLUMNS"
+       "    MARKER                 ''MARKER''                 ''INTORG''"
+       "    X1        COST         1.0   LIM1         1.0"
+       "    X1        LIM2         1.0"
+       "    MARKER                 ''MARKER''                 ''INTEND''"
+       "    X2        COST         2.0   LIM1         1.0"
+       "    X2        MYEQN       -1.0"
+       "    X3        COST        -1.0   MYEQN        1.0"
+       "RHS"
+       "    RHS       LIM1         4.0   LIM2         1.0"
+       "    RHS       MYEQN        7.0"
+       "BOUNDS"
+       " UP BND       X1           4.0"
+       " LO BND       X2          -1.0"
+       " UP BND       X2           1.0"
+       "ENDATA"];
+mpsFile = TMPDIR + "/testmip.mps";
+mputl(mps, mpsFile);
+
+sym_open();
+
+// sym_loadMPSFast and sym_loadMPS load the same problem
+sym_loadMPS(mpsFile);
+expected = sym_getModel();
+sym_solve();
+assert_close ( sym_getObjVal() , -7 , 1.e-7 );
+assert_close ( sym_getVarSoln() , [1 -1 6] , 1.e-7 );
+
+sym_loadMPSFast(mpsFile);
+check_same_model ( sym_getModel() , expected );
+sym_solve();
+assert_close ( sym_getObjVal() , -7 , 1.e-7 );
+assert_close ( sym_getVarSoln() , [1 -1 6] , 1.e-7 );
+
+// The sections are parsed the same way on several threads
+sym_loadMPSFast(mpsFile,2);
+check_same_model ( sym_getModel() , expected );
+
+sym_close();
+deletefile(mpsFile);
@@ -0,0 +1,98 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// Without an environment the functions that take indices only report it
+assert_checkequal( sym_setContinuous(0) , 1 );
+assert_checkequal( sym_setInteger(0) , 1 );
+
+// Objective function
+c = [350*5,330*3,310*4,280*6,500,450,400,100];
+
+// Bounds of variables
+lb = repmat(0,1,8);
+ub = [repmat(1,1,4) repmat(%inf,1,4)];
+
+// Constraint Matrix
+conMatrix = [5,3,4,6,1,1,1,1;
+             5*0.05,3*0.04,4*0.05,6*0.03,0.08,0.07,0.06,0.03;
+             5*0.03,3*0.03,4*0.04,6*0.04,0.06,0.07,0.08,0.09;];
+conlb = [ 25; 1.25; 1.25];
+conub = [ 25; 1.25; 1.25];
+
+isInt = [repmat(%t,1,4) repmat(%f,1,4)];
+
+sym_open();
+
+// Without presolve
+sym_setPresolve(0);
+sym_loadProblem(8,3,lb,ub,c,isInt,1,sparse(conMatrix),conlb,conub);
+sym_solve();
+f0 = sym_getObjVal();
+x0 = sym_getVarSoln();
+assert_close ( f0 , 8495 , 1.e-7 );
+
+// With presolve, the solution is given for the original problem
+sym_setPresolve(1);
+sym_loadProblem(8,3,lb,ub,c,isInt,1,sparse(conMatrix),conlb,conub);
+sym_solve();
+assert_close ( sym_getObjVal() , f0 , 1.e-7 );
+x1 = sym_getVarSoln();
+assert_checkequal( size(x1,"*") , 8 );
+assert_close ( conMatrix*x1(:) , conub , 1.e-7 );
+assert_close ( c*x1(:) , f0 , 1.e-7 );
+
+// The functions that take indices refuse the reduced problem
+assert_checktrue( execstr("sym_getNumVar()","errcatch") <> 0 );
+assert_checktrue( execstr("sym_setVarLower(0,0)","errcatch") <> 0 );
+
+sym_setPresolve(0);
+sym_close();
@@ -0,0 +1,84 @@
+// Copyright (C) 2015 - IIT Bombay - FOSSEE
+//
+// Organization: FOSSEE, IIT Bombay
+//
+// This file must be used under the terms of the CeCILL.
+// This source file is licensed as described in the file COPYING, which
+// you should have received as part of this distribution.  The terms
+// are also available at
+// http://www.cecill.info/licences/Licence_CeCILL_V2-en.txt
+
+// <-- JVM NOT MANDATORY -->
+// <-- ENGLISH IMPOSED -->
+
+
+//
+// assert_close --
+//   Returns 1 if the two real matrices computed and expected are close,
+//   i.e. if the relative distance between computed and expected is lesser than epsilon.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+function flag = assert_close ( computed, expected, epsilon )
+  if expected==0.0 then
+    shift = norm(computed-expected);
+  else
+    shift = norm(computed-expected)/norm(expected);
+  end
+//  if shift < epsilon then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+    flag = assert_checktrue ( shift < epsilon );
+endfunction
+//
+// assert_equal --
+//   Returns 1 if the two real matrices computed and expected are equal.
+// Arguments
+//   computed, expected : the two matrices to compare
+//   epsilon : a small number
+//
+//function flag = assert_equal ( computed , expected )
+//  if computed==expected then
+//    flag = 1;
+//  else
+//    flag = 0;
+//  end
+//  if flag <> 1 then pause,end
+//endfunction
+
+// min -5*x1 - 4*x2 s.t. 6*x1 + 4*x2 <= b, x1 + 2*x2 <= 6, with x1 and x2 integers
+c = [-5 -4];
+lb = [0 0];
+ub = [10 10];
+A = [6 4;
+     1 2];
+conlb = [-%inf; -%inf];
+conub = [24; 6];
+isInt = [%t %t];
+
+// The optimum for b = 12, 18 and 24
+grid = [12; 18; 24];
+expected = [-12; -15; -20];
+
+sym_open();
+sym_loadProblem(2,2,lb,ub,c,isInt,1,sparse(A),conlb,conub);
+
+// Cuts are generated by default, so Symphony refuses to warm start a change of right hand side
+[objVals, solutions, statuses] = sym_sweep("rhs", 0, grid);
+assert_close ( objVals , expected , 1.e-7 );
+assert_close ( solutions*c' , expected , 1.e-7 );
+assert_checktrue( and(A(1,:)*solutions' <= grid' + 1.e-7) );
+
+// The same points on two threads
+objVals = sym_sweep("rhs", 0, grid, 2);
+assert_close ( objVals , expected , 1.e-7 );
+
+// Sweeping the objective coefficient of x2: x = [4 0] stays optimal while it is above -5
+objVals = sym_sweep("obj", 1, [-2; -3]);
+assert_close ( objVals , [-20; -20] , 1.e-7 );
+
+sym_close();
@@ -72,9 +72,19 @@ beq = [ 25, 1.25, 1.25]
 intcon = [1 2 3 4];
 
 // Calling Symphony
-[x,f,status,output] = symphony_mat(c,intcon,[],[],Aeq,beq,lb,ub);
+[x,f,status,output] = symphonymat(c,intcon,[],[],Aeq,beq,lb,ub);
 
 assert_close ( x , [1 1 0 1 7.25 0 0.25 3.5]' , 1.e-7 );
 assert_close ( f , [ 8495] , 1.e-7 );
 
 assert_checkequal( status , 227 );
+
+// The fourth output is the output structure, as for symphony
+assert_checkequal( typeof(output) , "st" );
+assert_checktrue( output.Iterations >= 1 );
+
+// The node count and the bounds of an optimal solve are asked from Symphony
+assert_checkequal( output.analyzedNodes , output.Iterations );
+assert_close ( output.upperBound , f , 1.e-7 );
+assert_close ( output.lowerBound , f , 1.e-7 );
+assert_checkequal( output.gap , 0 );